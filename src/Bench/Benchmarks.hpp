@@ -0,0 +1,73 @@
+#ifndef BENCH_BENCHMARKS
+#define BENCH_BENCHMARKS
+
+#include "Harness.hpp"
+#include "../Play/Detail.hpp"
+#include "../Server/Server.hpp"
+#include "../Hamurabi/Game.hpp"
+#include "../Hamurabi/GreedyPolicy.hpp"
+#include "../Hamurabi/FeasibleActions.hpp"
+
+namespace bench {
+
+// the game and the random helpers it draws from, for one generator type
+template<class T>
+static inline void RunGameBenchmarks(Harness &harness, std::string_view generator_name, const T &generator);
+
+static inline void RunValidationBenchmarks(Harness &harness);
+
+static inline void RunSerializationBenchmarks(Harness &harness);
+
+static inline void RunPlayBenchmarks(Harness &harness);
+
+// waves of greedy games played at once through a server on a unix socket
+static inline void RunServerBenchmarks(Harness &harness);
+
+namespace detail {
+
+// inputs of a whole game, valid again for any game started from an equal generator
+template<class T>
+[[nodiscard]]
+static inline std::vector<hamurabi::RoundInput> RecordGreedyGame(const T &generator);
+
+template<class T>
+[[nodiscard]]
+static inline hamurabi::Game<T> PlayGreedyRounds(const T &generator, hamurabi::Round rounds);
+
+// sessions of a wave, their descriptors on both ends stay well within the default limit of 1024
+inline constexpr std::size_t kLoopbackWaveSize = 250;
+
+inline constexpr std::uint64_t kLoopbackSeed = 0;
+
+// a socket of this process in the temporary directory
+[[nodiscard]]
+static inline std::filesystem::path LoopbackPath();
+
+// the lines of the greedy game of every session of a wave, in the order a server seeded with kLoopbackSeed
+// numbers them
+[[nodiscard]]
+static inline std::vector<std::string> InsertLoopbackWave();
+
+// the answers to the prompts of a session, four lines a round
+[[nodiscard]]
+static inline std::string InsertPromptedLines(std::span<const hamurabi::RoundInput> inputs);
+
+// what the server prints for the lines to the session of the seed
+[[nodiscard]]
+static inline std::string PlayPromptedSession(std::uint64_t seed, std::string_view lines);
+
+// sends the lines and ends the input, -1 on failure
+[[nodiscard]]
+static inline int ConnectLoopbackClient(const std::filesystem::path &path, std::string_view lines);
+
+// everything the server sends until it closes, nothing on failure
+[[nodiscard]]
+static inline std::optional<std::string> ReceiveTranscript(int descriptor);
+
+}
+
+}
+
+#include "Benchmarks.inl"
+
+#endif //BENCH_BENCHMARKS
@@ -0,0 +1,309 @@
+#ifndef BENCH_BENCHMARKS_INL
+#define BENCH_BENCHMARKS_INL
+
+#include <array>
+#include <thread>
+#include <cstring>
+#include <sstream>
+
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+namespace bench {
+
+namespace detail {
+
+template<class T>
+std::vector<hamurabi::RoundInput> RecordGreedyGame(const T &generator) {
+    hamurabi::Game game{T{generator}};
+    std::vector<hamurabi::RoundInput> inputs;
+    while (true) {
+        inputs.push_back(hamurabi::GreedyPolicy{}(game));
+        if (!std::holds_alternative<hamurabi::Continue>(game.PlayRound(inputs.back()))) {
+            return inputs;
+        }
+    }
+}
+
+template<class T>
+hamurabi::Game<T> PlayGreedyRounds(const T &generator, const hamurabi::Round rounds) {
+    hamurabi::Game game{T{generator}};
+    for (hamurabi::Round round = 0; round < rounds; ++round) {
+        if (!std::holds_alternative<hamurabi::Continue>(game.PlayRound(hamurabi::GreedyPolicy{}(game)))) {
+            break;
+        }
+    }
+    return game;
+}
+
+std::filesystem::path LoopbackPath() {
+    return std::filesystem::temp_directory_path() / ("hamurabi_bench_" + std::to_string(::getpid()) + ".sock");
+}
+
+std::vector<std::string> InsertLoopbackWave() {
+    std::vector<std::string> lines;
+    lines.reserve(kLoopbackWaveSize);
+    for (std::uint64_t session = 0; session < kLoopbackWaveSize; ++session) {
+        lines.push_back(InsertPromptedLines(RecordGreedyGame(std::mt19937_64{kLoopbackSeed + session})));
+    }
+    return lines;
+}
+
+std::string InsertPromptedLines(const std::span<const hamurabi::RoundInput> inputs) {
+    std::string lines;
+    for (const auto &input : inputs) {
+        for (const auto value : {static_cast<hamurabi::Acres>(input.AreaToBuy()),
+                                 static_cast<hamurabi::Acres>(input.AreaToSell()),
+                                 static_cast<hamurabi::Bushels>(input.GrainToFeed()),
+                                 static_cast<hamurabi::Acres>(input.AreaToPlant())}) {
+            lines += std::to_string(value);
+            lines += '\n';
+        }
+    }
+    return lines;
+}
+
+std::string PlayPromptedSession(const std::uint64_t seed, std::string_view lines) {
+    play::Session session{hamurabi::Game{std::mt19937_64{seed}}};
+    play::OutputSink sink;
+    session.Start(sink);
+    while (!session.IsFinished() && !lines.empty()) {
+        const auto line_end = lines.find('\n');
+        session.Feed(lines.substr(0, line_end), sink);
+        lines.remove_prefix(line_end + 1);
+    }
+    return std::string{sink.Buffer()};
+}
+
+int ConnectLoopbackClient(const std::filesystem::path &path, std::string_view lines) {
+    sockaddr_un address{};
+    if (path.native().size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.native().size());
+    const auto descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor < 0) {
+        return -1;
+    }
+    if (::connect(descriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        ::close(descriptor);
+        return -1;
+    }
+    // a whole game is far below the socket buffer, so the lines go out before any answer is read
+    while (!lines.empty()) {
+        const auto size = ::send(descriptor, lines.data(), lines.size(), MSG_NOSIGNAL);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            ::close(descriptor);
+            return -1;
+        }
+        lines.remove_prefix(static_cast<std::size_t>(size));
+    }
+    ::shutdown(descriptor, SHUT_WR);
+    return descriptor;
+}
+
+std::optional<std::string> ReceiveTranscript(const int descriptor) {
+    std::string transcript;
+    std::array<char, 4096> buffer{};
+    while (true) {
+        const auto size = ::recv(descriptor, buffer.data(), buffer.size(), 0);
+        if (size > 0) {
+            transcript.append(buffer.data(), static_cast<std::size_t>(size));
+        } else if (size == 0) {
+            return transcript;
+        } else if (errno != EINTR) {
+            return std::nullopt;
+        }
+    }
+}
+
+}
+
+template<class T>
+void RunGameBenchmarks(Harness &harness, const std::string_view generator_name, const T &generator) {
+    const auto name = [generator_name](const std::string_view benchmark) {
+        return std::string{benchmark} + "/" + std::string{generator_name};
+    };
+
+    harness.Run(name("Game/Construct"), [&generator] {
+        hamurabi::Game game{T{generator}};
+        DoNotOptimize(game);
+    });
+
+    // every game replays the same inputs from the same generator, starting over costs one Construct per game
+    const auto inputs = detail::RecordGreedyGame(generator);
+    hamurabi::Game game{T{generator}};
+    std::size_t round = 0;
+    harness.Run(name("Game/PlayRound"), [&] {
+        if (round == inputs.size()) {
+            game = hamurabi::Game{T{generator}};
+            round = 0;
+        }
+        const auto round_result = game.PlayRound(inputs[round++]);
+        DoNotOptimize(round_result);
+    });
+
+    auto random = T{generator};
+    hamurabi::detail::Distributions distributions{};
+    harness.Run(name("Detail/GenerateAcrePrice"), [&] {
+        DoNotOptimize(hamurabi::detail::GenerateAcrePrice(random, distributions));
+    });
+    harness.Run(name("Detail/GenerateGrainHarvestedFromAcre"), [&] {
+        DoNotOptimize(hamurabi::detail::GenerateGrainHarvestedFromAcre(random, distributions));
+    });
+    harness.Run(name("Detail/GenerateGrainEatenByRats"), [&] {
+        DoNotOptimize(hamurabi::detail::GenerateGrainEatenByRats(random, distributions, 2800));
+    });
+    harness.Run(name("Detail/GenerateIsPlague"), [&] {
+        DoNotOptimize(hamurabi::detail::GenerateIsPlague(random, distributions));
+    });
+}
+
+void RunValidationBenchmarks(Harness &harness) {
+    const auto game = detail::PlayGreedyRounds(std::mt19937_64{}, 3);
+    const auto input = hamurabi::GreedyPolicy{}(game);
+    const auto area_to_buy = std::get<hamurabi::AreaToBuy>(hamurabi::AreaToBuy::New(0, game));
+    const auto area_to_sell = std::get<hamurabi::AreaToSell>(hamurabi::AreaToSell::New(0, game));
+    const auto grain_to_feed = std::get<hamurabi::GrainToFeed>(
+        hamurabi::GrainToFeed::New(static_cast<hamurabi::Bushels>(input.GrainToFeed()), game));
+    const auto area_to_plant = std::get<hamurabi::AreaToPlant>(
+        hamurabi::AreaToPlant::New(static_cast<hamurabi::Acres>(input.AreaToPlant()), game));
+
+    harness.Run("RoundInput/New", [&] {
+        DoNotOptimize(hamurabi::RoundInput::New(area_to_buy, area_to_sell, grain_to_feed, area_to_plant, game));
+    });
+    harness.Run("AreaToPlant/New", [&] {
+        DoNotOptimize(hamurabi::AreaToPlant::New(static_cast<hamurabi::Acres>(input.AreaToPlant()), game));
+    });
+
+    const hamurabi::FeasibleRegion region{game};
+    harness.Run("FeasibleRegion/New", [&] {
+        DoNotOptimize(hamurabi::FeasibleRegion{game});
+    });
+    harness.Run("RoundInput/New/FeasibleRegion", [&] {
+        DoNotOptimize(hamurabi::RoundInput::New(area_to_buy, area_to_sell, grain_to_feed, area_to_plant, game, region));
+    });
+    harness.Run("AreaToPlant/New/FeasibleRegion", [&] {
+        DoNotOptimize(hamurabi::AreaToPlant::New(static_cast<hamurabi::Acres>(input.AreaToPlant()), game, region));
+    });
+
+    const hamurabi::FeasibleActions actions{game};
+    std::mt19937_64 random{};
+    harness.Run("FeasibleActions/New", [&] {
+        DoNotOptimize(hamurabi::FeasibleActions{game}.Size());
+    });
+    harness.Run("FeasibleActions/Sample", [&] {
+        DoNotOptimize(actions.Sample(random));
+    });
+}
+
+void RunSerializationBenchmarks(Harness &harness) {
+    namespace ser = hamurabi::serialization;
+
+    const auto game = detail::PlayGreedyRounds(std::mt19937_64{}, 3);
+    auto extracted = hamurabi::Game{std::mt19937_64{}};
+
+    std::stringstream yaml;
+    harness.Run("Serialization/InsertGame/YAML", [&] {
+        yaml.seekp(0);
+        ser::InsertGame(yaml, game, ser::Format::YAML);
+    });
+    yaml.str({});
+    ser::InsertGame(yaml, game, ser::Format::YAML);
+    const auto yaml_text = yaml.str();
+    harness.Run("Serialization/ExtractGame/YAML", [&] {
+        yaml.clear();
+        yaml.seekg(0);
+        DoNotOptimize(ser::ExtractGame(yaml, extracted, ser::Format::YAML));
+    });
+    harness.Run("Serialization/ExtractGame/YAMLView", [&] {
+        DoNotOptimize(ser::ExtractGame(std::string_view{yaml_text}, extracted));
+    });
+
+    std::array<std::byte, ser::kBinaryGameSize> bytes{};
+    harness.Run("Serialization/InsertGame/Binary", [&] {
+        ser::InsertGame(std::span{bytes}, game);
+        DoNotOptimize(bytes);
+    });
+    harness.Run("Serialization/ExtractGame/Binary", [&] {
+        DoNotOptimize(ser::ExtractGame(std::span<const std::byte, ser::kBinaryGameSize>{bytes}, extracted));
+    });
+}
+
+void RunPlayBenchmarks(Harness &harness) {
+    const auto game = detail::PlayGreedyRounds(std::mt19937_64{}, 3);
+    // greedy play often starves the city, the first seed it survives with gives the statistics
+    std::optional<hamurabi::Statistics> statistics;
+    for (std::uint64_t seed = 0; seed < 1024 && !statistics.has_value(); ++seed) {
+        statistics = detail::PlayGreedyRounds(std::mt19937_64{seed}, hamurabi::detail::kLastRound).Statistics();
+    }
+
+    // the sink is drained after every report, so it measures formatting and not the growth of the buffer
+    play::OutputSink sink;
+    harness.Run("Play/InsertGreetings", [&sink] {
+        play::detail::InsertGreetings(sink);
+        sink.Consume(sink.Buffer().size());
+    });
+    harness.Run("Play/InsertGameState", [&sink, &game] {
+        play::detail::InsertGameState(sink, game);
+        sink.Consume(sink.Buffer().size());
+    });
+    if (statistics.has_value()) {
+        harness.Run("Play/InsertGameStatistics", [&sink, &statistics] {
+            play::detail::InsertGameStatistics(sink, *statistics);
+            sink.Consume(sink.Buffer().size());
+        });
+    }
+    harness.Run("Play/ParseUnsigned", [] {
+        DoNotOptimize(play::detail::ParseUnsigned<hamurabi::Acres>("1234"));
+    });
+    harness.Run("Play/ParseRoundLine", [] {
+        DoNotOptimize(play::detail::ParseRoundLine("0 0 2000 1000"));
+    });
+}
+
+void RunServerBenchmarks(Harness &harness) {
+    constexpr std::string_view kName = "Server/LoopbackWave";
+    if (!harness.IsSelected(kName)) {
+        return;
+    }
+    // a server which cannot listen would leave nothing to time
+    const auto path = detail::LoopbackPath();
+    if (!server::Server::Open({.unix_path = path, .seed = detail::kLoopbackSeed}).has_value()) {
+        return;
+    }
+    const auto lines = detail::InsertLoopbackWave();
+
+    // the server numbers sessions from its seed in the order the clients connect, so every wave meets a new
+    // server to play the games its lines were recorded for, opening one costs little next to a wave
+    std::vector<int> descriptors;
+    descriptors.reserve(lines.size());
+    harness.Run(kName, [&] {
+        auto server = server::Server::Open({.unix_path = path, .seed = detail::kLoopbackSeed});
+        if (!server.has_value()) {
+            return;
+        }
+        std::thread thread{[&server] { server->Run(); }};
+        for (const auto &session_lines : lines) {
+            descriptors.push_back(detail::ConnectLoopbackClient(path, session_lines));
+        }
+        for (const auto descriptor : descriptors) {
+            if (descriptor >= 0) {
+                DoNotOptimize(detail::ReceiveTranscript(descriptor));
+                ::close(descriptor);
+            }
+        }
+        descriptors.clear();
+        server->Stop();
+        thread.join();
+    });
+}
+
+}
+
+#endif //BENCH_BENCHMARKS_INL
@@ -0,0 +1,102 @@
+#ifndef BENCH_HARNESS
+#define BENCH_HARNESS
+
+#include <span>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <optional>
+#include <filesystem>
+#include <string_view>
+
+namespace bench {
+
+struct Options final {
+    std::size_t samples = 20;
+    std::chrono::nanoseconds sample_time = std::chrono::milliseconds{5};
+    std::string filter;
+    // results of an earlier run to compare with, and where to keep the results of this one
+    std::filesystem::path baseline;
+    std::filesystem::path output;
+};
+
+// times are in nanoseconds per operation
+struct Result final {
+    std::string name;
+    std::size_t samples;
+    double mean;
+    double deviation;
+    double median;
+    double minimum;
+};
+
+[[nodiscard]]
+static inline std::optional<Options> ExtractOptions(std::span<const std::string_view> arguments);
+
+static inline void InsertUsage(std::ostream &ostream);
+
+// keeps the compiler from dropping a computation whose result is never used
+template<class T>
+static inline void DoNotOptimize(const T &value) noexcept;
+
+// every benchmark is sampled repeatedly, each sample long enough for the clock, and reported with its 95% interval
+class Harness final {
+  public:
+    Harness(std::ostream &ostream, Options options);
+
+    // benchmarks with an expensive setup ask first, so a filter skips it too
+    [[nodiscard]]
+    bool IsSelected(std::string_view name) const noexcept;
+
+    template<class F>
+    void Run(std::string_view name, F operation);
+
+    [[nodiscard]]
+    const std::vector<Result> &Results() const noexcept;
+
+    // compares with the baseline and saves the results when the options ask for it
+    [[nodiscard]]
+    bool Finish();
+
+  private:
+    std::ostream *ostream_;
+    Options options_;
+    std::vector<Result> baseline_;
+    std::vector<Result> results_;
+};
+
+namespace detail {
+
+[[nodiscard]]
+static inline Result Summarize(std::string name, std::vector<double> samples);
+
+// two-sided 95% quantile of Student's t distribution
+[[nodiscard]]
+static inline double CriticalT(double degrees_of_freedom) noexcept;
+
+[[nodiscard]]
+static inline double ConfidenceInterval(const Result &result) noexcept;
+
+struct WelchTest final {
+    double t;
+    double degrees_of_freedom;
+};
+
+[[nodiscard]]
+static inline WelchTest Welch(const Result &lhs, const Result &rhs) noexcept;
+
+static inline void InsertResult(std::ostream &ostream, const Result &result, const Result *baseline);
+
+static inline void InsertResults(std::ostream &ostream, std::span<const Result> results);
+
+[[nodiscard]]
+static inline std::optional<std::vector<Result>> ExtractResults(std::istream &istream);
+
+}
+
+}
+
+#include "Harness.inl"
+
+#endif //BENCH_HARNESS
@@ -0,0 +1,233 @@
+#ifndef BENCH_HARNESS_INL
+#define BENCH_HARNESS_INL
+
+#include <cmath>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <charconv>
+#include <algorithm>
+
+namespace bench {
+
+std::optional<Options> ExtractOptions(const std::span<const std::string_view> arguments) {
+    Options options{};
+    for (std::size_t index = 0; index < arguments.size(); ++index) {
+        const auto argument = arguments[index];
+        if (index + 1 >= arguments.size()) {
+            return std::nullopt;
+        }
+        const auto value = arguments[++index];
+        std::uint64_t number = 0;
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+        const auto is_number = error == std::errc{} && end == value.data() + value.size();
+        if (argument == "--samples" && is_number && number >= 2) {
+            options.samples = static_cast<std::size_t>(number);
+        } else if (argument == "--sample-ms" && is_number && number != 0) {
+            options.sample_time = std::chrono::milliseconds{number};
+        } else if (argument == "--filter") {
+            options.filter = value;
+        } else if (argument == "--baseline") {
+            options.baseline = value;
+        } else if (argument == "--output") {
+            options.output = value;
+        } else {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+void InsertUsage(std::ostream &ostream) {
+    ostream << "usage: hamurabi_bench [--samples N] [--sample-ms MS] [--filter TEXT]\n"
+               "                      [--baseline FILE] [--output FILE]\n";
+}
+
+template<class T>
+void DoNotOptimize(const T &value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline Harness::Harness(std::ostream &ostream, Options options)
+    : ostream_{&ostream},
+      options_{std::move(options)} {
+    if (!options_.baseline.empty()) {
+        std::ifstream file{options_.baseline};
+        if (auto baseline = detail::ExtractResults(file)) {
+            baseline_ = std::move(*baseline);
+        } else {
+            *ostream_ << "hamurabi_bench: cannot read baseline " << options_.baseline << "\n";
+        }
+    }
+}
+
+inline bool Harness::IsSelected(const std::string_view name) const noexcept {
+    return name.find(options_.filter) != std::string_view::npos;
+}
+
+template<class F>
+void Harness::Run(const std::string_view name, F operation) {
+    if (!IsSelected(name)) {
+        return;
+    }
+    using Clock = std::chrono::steady_clock;
+    const auto time = [&operation](const std::uint64_t iterations) {
+        const auto start = Clock::now();
+        for (std::uint64_t iteration = 0; iteration < iterations; ++iteration) {
+            operation();
+        }
+        return Clock::now() - start;
+    };
+
+    // doubles the iterations until a sample is long enough, which also warms caches and branch predictors
+    std::uint64_t iterations = 1;
+    auto elapsed = time(iterations);
+    while (elapsed < options_.sample_time / 8) {
+        iterations *= 2;
+        elapsed = time(iterations);
+    }
+    const auto elapsed_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    const auto target_ns = static_cast<double>(options_.sample_time.count());
+    iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(
+        static_cast<double>(iterations) * target_ns / std::max(elapsed_ns, 1.0)));
+
+    std::vector<double> samples;
+    samples.reserve(options_.samples);
+    for (std::size_t sample = 0; sample < options_.samples; ++sample) {
+        const auto sample_ns = std::chrono::duration<double, std::nano>(time(iterations)).count();
+        samples.push_back(sample_ns / static_cast<double>(iterations));
+    }
+
+    auto result = detail::Summarize(std::string{name}, std::move(samples));
+    const auto baseline = std::find_if(baseline_.begin(), baseline_.end(), [&result](const Result &entry) {
+        return entry.name == result.name;
+    });
+    detail::InsertResult(*ostream_, result, baseline == baseline_.end() ? nullptr : &*baseline);
+    results_.push_back(std::move(result));
+}
+
+inline const std::vector<Result> &Harness::Results() const noexcept {
+    return results_;
+}
+
+inline bool Harness::Finish() {
+    if (options_.output.empty()) {
+        return true;
+    }
+    std::ofstream file{options_.output};
+    detail::InsertResults(file, results_);
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+namespace detail {
+
+Result Summarize(std::string name, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const auto count = static_cast<double>(samples.size());
+    const auto mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+    const auto squares = std::accumulate(samples.begin(), samples.end(), 0.0, [mean](double sum, double sample) {
+        return sum + (sample - mean) * (sample - mean);
+    });
+    const auto middle = samples.size() / 2;
+    return Result{
+        .name = std::move(name),
+        .samples = samples.size(),
+        .mean = mean,
+        .deviation = samples.size() > 1 ? std::sqrt(squares / (count - 1)) : 0.0,
+        .median = samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2,
+        .minimum = samples.front(),
+    };
+}
+
+double CriticalT(const double degrees_of_freedom) noexcept {
+    constexpr std::array<double, 30> kTable = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (degrees_of_freedom < 1) {
+        return kTable.front();
+    }
+    if (degrees_of_freedom <= static_cast<double>(kTable.size())) {
+        return kTable[static_cast<std::size_t>(degrees_of_freedom) - 1];
+    }
+    // the quantile approaches the normal one quickly after thirty degrees of freedom
+    return 1.960 + 2.4 / degrees_of_freedom;
+}
+
+double ConfidenceInterval(const Result &result) noexcept {
+    const auto count = static_cast<double>(result.samples);
+    return CriticalT(count - 1) * result.deviation / std::sqrt(count);
+}
+
+WelchTest Welch(const Result &lhs, const Result &rhs) noexcept {
+    const auto lhs_variance = lhs.deviation * lhs.deviation / static_cast<double>(lhs.samples);
+    const auto rhs_variance = rhs.deviation * rhs.deviation / static_cast<double>(rhs.samples);
+    const auto variance = lhs_variance + rhs_variance;
+    if (variance == 0) {
+        return {.t = lhs.mean == rhs.mean ? 0.0 : INFINITY, .degrees_of_freedom = 1};
+    }
+    const auto lhs_part = lhs_variance * lhs_variance / static_cast<double>(lhs.samples - 1);
+    const auto rhs_part = rhs_variance * rhs_variance / static_cast<double>(rhs.samples - 1);
+    return {
+        .t = (lhs.mean - rhs.mean) / std::sqrt(variance),
+        .degrees_of_freedom = variance * variance / std::max(lhs_part + rhs_part, 1e-300),
+    };
+}
+
+void InsertResult(std::ostream &ostream, const Result &result, const Result *baseline) {
+    const auto interval = ConfidenceInterval(result);
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2) << std::left << std::setw(56) << result.name << std::right
+         << std::setw(12) << result.mean << " ns/op +- " << std::setw(8) << interval
+         << " (" << std::setw(5) << 100 * interval / std::max(result.mean, 1e-9) << "%)"
+         << "  median " << std::setw(10) << result.median
+         << "  min " << std::setw(10) << result.minimum;
+    if (baseline != nullptr) {
+        const auto welch = Welch(result, *baseline);
+        const auto change = 100 * (result.mean - baseline->mean) / std::max(baseline->mean, 1e-9);
+        line << "  vs baseline " << std::showpos << change << std::noshowpos << "%"
+             << (std::abs(welch.t) > CriticalT(welch.degrees_of_freedom) ? " significant" : " not significant");
+    }
+    line << "\n";
+    ostream << std::move(line).str() << std::flush;
+}
+
+// one result per line: name,samples,mean,deviation,median,minimum
+void InsertResults(std::ostream &ostream, const std::span<const Result> results) {
+    ostream << std::setprecision(17);
+    for (const auto &result : results) {
+        ostream << result.name << ',' << result.samples << ',' << result.mean << ',' << result.deviation << ','
+                << result.median << ',' << result.minimum << '\n';
+    }
+}
+
+std::optional<std::vector<Result>> ExtractResults(std::istream &istream) {
+    if (!istream) {
+        return std::nullopt;
+    }
+    std::vector<Result> results;
+    std::string line;
+    while (std::getline(istream, line)) {
+        std::istringstream fields{line};
+        Result result{};
+        char delim = 0;
+        if (!std::getline(fields, result.name, ',') ||
+            !(fields >> result.samples >> delim >> result.mean >> delim >> result.deviation >> delim
+                     >> result.median >> delim >> result.minimum) ||
+            result.samples < 2) {
+            return std::nullopt;
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+}
+
+}
+
+#endif //BENCH_HARNESS_INL
@@ -0,0 +1,28 @@
+#include <vector>
+#include <iostream>
+
+#include "Benchmarks.hpp"
+#include "../Hamurabi/CounterGenerator.hpp"
+
+int main(int argc, char *argv[]) {
+    const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+    const auto options = bench::ExtractOptions(arguments);
+    if (!options.has_value()) {
+        bench::InsertUsage(std::cerr);
+        return 1;
+    }
+
+#ifndef NDEBUG
+    std::cerr << "hamurabi_bench: built without NDEBUG, configure with -DCMAKE_BUILD_TYPE=Release\n";
+#endif
+    bench::Harness harness{std::cout, options.value()};
+    bench::RunGameBenchmarks(harness, "mt19937_64", std::mt19937_64{});
+    bench::RunGameBenchmarks(harness, "mt19937", std::mt19937{});
+    bench::RunGameBenchmarks(harness, "minstd_rand", std::minstd_rand{});
+    bench::RunGameBenchmarks(harness, "CounterGenerator", hamurabi::CounterGenerator{});
+    bench::RunValidationBenchmarks(harness);
+    bench::RunSerializationBenchmarks(harness);
+    bench::RunPlayBenchmarks(harness);
+    bench::RunServerBenchmarks(harness);
+    return harness.Finish() ? 0 : 1;
+}
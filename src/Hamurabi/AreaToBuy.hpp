@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "NotEnoughGrain.hpp"
+#include "FeasibleRegion.hpp"
 
 namespace hamurabi {
 
@@ -12,8 +13,12 @@ using AreaToBuyResult = std::variant<AreaToBuy, NotEnoughGrain>;
 
 class AreaToBuy final {
   public:
-    template<class T>
-    constexpr static AreaToBuyResult New(Acres area_to_buy, const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr static AreaToBuyResult New(Acres area_to_buy, const G &game) noexcept;
+
+    // the same check against bounds computed for the game before
+    template<GameState G>
+    constexpr static AreaToBuyResult New(Acres area_to_buy, const G &game, const FeasibleRegion &region) noexcept;
 
     constexpr explicit operator Acres() const noexcept;
 
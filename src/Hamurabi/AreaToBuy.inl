@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr AreaToBuyResult AreaToBuy::New(const Acres area_to_buy, const Game<T> &game) noexcept {
+template<GameState G>
+constexpr AreaToBuyResult AreaToBuy::New(const Acres area_to_buy, const G &game) noexcept {
     const auto grain = game.Grain();
     const auto acre_price = game.AcrePrice();
     const auto total_price = area_to_buy * acre_price;
@@ -14,6 +14,14 @@ constexpr AreaToBuyResult AreaToBuy::New(const Acres area_to_buy, const Game<T>
     return AreaToBuy{area_to_buy};
 }
 
+template<GameState G>
+constexpr AreaToBuyResult AreaToBuy::New(const Acres area_to_buy, const G &game, const FeasibleRegion &region) noexcept {
+    if (area_to_buy > region.MaxAreaToBuy()) {
+        return NotEnoughGrain{game};
+    }
+    return AreaToBuy{area_to_buy};
+}
+
 constexpr AreaToBuy::operator Acres() const noexcept {
     return area_to_buy_;
 }
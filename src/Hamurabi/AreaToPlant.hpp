@@ -6,6 +6,7 @@
 #include "NotEnoughArea.hpp"
 #include "NotEnoughGrain.hpp"
 #include "NotEnoughPeople.hpp"
+#include "FeasibleRegion.hpp"
 #include "Detail.hpp"
 
 namespace hamurabi {
@@ -15,8 +16,12 @@ using AreaToPlantResult = std::variant<AreaToPlant, NotEnoughArea, NotEnoughGrai
 
 class AreaToPlant final {
   public:
-    template<class T>
-    constexpr static AreaToPlantResult New(Acres area_to_plant, const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr static AreaToPlantResult New(Acres area_to_plant, const G &game) noexcept;
+
+    // the same check against bounds computed for the game before
+    template<GameState G>
+    constexpr static AreaToPlantResult New(Acres area_to_plant, const G &game, const FeasibleRegion &region) noexcept;
 
     constexpr explicit operator Acres() const noexcept;
 
@@ -3,23 +3,38 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr AreaToPlantResult AreaToPlant::New(const Acres area_to_plant, const Game<T> &game) noexcept {
+template<GameState G>
+constexpr AreaToPlantResult AreaToPlant::New(const Acres area_to_plant, const G &game) noexcept {
+    const auto &rules = detail::RulesOf(game);
     const auto area = game.Area();
     if (area_to_plant > area) {
         return NotEnoughArea{game};
     }
     const auto grain = game.Grain();
-    if (area_to_plant > detail::AreaCanPlantWithGrain(grain)) {
+    if (area_to_plant > detail::AreaCanPlantWithGrain(grain, rules)) {
         return NotEnoughGrain{game};
     }
     const auto population = game.Population();
-    if (area_to_plant > detail::AreaCanPlantWithPopulation(population)) {
+    if (area_to_plant > detail::AreaCanPlantWithPopulation(population, rules)) {
         return NotEnoughPeople{game};
     }
     return AreaToPlant{area_to_plant};
 }
 
+template<GameState G>
+constexpr AreaToPlantResult AreaToPlant::New(const Acres area_to_plant, const G &game, const FeasibleRegion &region) noexcept {
+    if (area_to_plant <= region.MaxAreaToPlant()) {
+        return AreaToPlant{area_to_plant};
+    }
+    if (area_to_plant > game.Area()) {
+        return NotEnoughArea{game};
+    }
+    if (area_to_plant > region.MaxAreaToPlantWithGrain()) {
+        return NotEnoughGrain{game};
+    }
+    return NotEnoughPeople{game};
+}
+
 constexpr AreaToPlant::operator Acres() const noexcept {
     return area_to_plant_;
 }
@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "NotEnoughArea.hpp"
+#include "FeasibleRegion.hpp"
 
 namespace hamurabi {
 
@@ -12,8 +13,12 @@ using AreaToSellResult = std::variant<AreaToSell, NotEnoughArea>;
 
 class AreaToSell final {
   public:
-    template<class T>
-    constexpr static AreaToSellResult New(Acres area_to_sell, const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr static AreaToSellResult New(Acres area_to_sell, const G &game) noexcept;
+
+    // the same check against bounds computed for the game before
+    template<GameState G>
+    constexpr static AreaToSellResult New(Acres area_to_sell, const G &game, const FeasibleRegion &region) noexcept;
 
     constexpr explicit operator Acres() const noexcept;
 
@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr AreaToSellResult AreaToSell::New(const Acres area_to_sell, const Game <T> &game) noexcept {
+template<GameState G>
+constexpr AreaToSellResult AreaToSell::New(const Acres area_to_sell, const G &game) noexcept {
     const auto area = game.Area();
     if (area_to_sell > area) {
         return NotEnoughArea{game};
@@ -12,6 +12,14 @@ constexpr AreaToSellResult AreaToSell::New(const Acres area_to_sell, const Game
     return AreaToSell{area_to_sell};
 }
 
+template<GameState G>
+constexpr AreaToSellResult AreaToSell::New(const Acres area_to_sell, const G &game, const FeasibleRegion &region) noexcept {
+    if (area_to_sell > region.MaxAreaToSell()) {
+        return NotEnoughArea{game};
+    }
+    return AreaToSell{area_to_sell};
+}
+
 constexpr AreaToSell::operator Acres() const noexcept {
     return area_to_sell_;
 }
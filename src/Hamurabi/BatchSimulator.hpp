@@ -0,0 +1,45 @@
+#ifndef HAMURABI_BATCH_SIMULATOR
+#define HAMURABI_BATCH_SIMULATOR
+
+#include <span>
+#include <utility>
+#include <vector>
+#include <variant>
+
+#include "Game.hpp"
+#include "Policy.hpp"
+
+namespace hamurabi {
+
+using GameOutcome = std::variant<Statistics, GameOver>;
+
+template<class T, class I, class R, Policy<T> P>
+[[nodiscard]]
+static inline GameOutcome PlayGame(Game<T, I, R> &game, P &policy);
+
+// observe sees the game after every played round
+template<class T, class I, class R, Policy<T> P, std::invocable<const Game<T, I, R> &> O>
+[[nodiscard]]
+static inline GameOutcome PlayGame(Game<T, I, R> &game, P &policy, O observe);
+
+template<class T, Policy<T> P>
+class BatchSimulator final {
+  public:
+    using Seed = typename T::result_type;
+
+    constexpr explicit BatchSimulator(P policy);
+
+    [[nodiscard]]
+    std::vector<GameOutcome> Run(std::span<const Seed> seeds);
+
+    void Run(std::span<const Seed> seeds, std::span<GameOutcome> outcomes);
+
+  private:
+    P policy_;
+};
+
+}
+
+#include "BatchSimulator.inl"
+
+#endif //HAMURABI_BATCH_SIMULATOR
@@ -0,0 +1,63 @@
+#ifndef HAMURABI_BATCH_SIMULATOR_INL
+#define HAMURABI_BATCH_SIMULATOR_INL
+
+#include <cassert>
+
+namespace hamurabi {
+
+template<class T, class I, class R, Policy<T> P>
+GameOutcome PlayGame(Game<T, I, R> &game, P &policy) {
+    while (true) {
+        const RoundInput input = policy(std::as_const(game));
+        const auto round_result = game.PlayRound(input);
+        if (const auto game_over = std::get_if<GameOver>(&round_result)) {
+            return *game_over;
+        }
+        if (std::holds_alternative<GameEnd>(round_result)) {
+            return game.Statistics().value();
+        }
+    }
+}
+
+template<class T, class I, class R, Policy<T> P, std::invocable<const Game<T, I, R> &> O>
+GameOutcome PlayGame(Game<T, I, R> &game, P &policy, O observe) {
+    while (true) {
+        const RoundInput input = policy(std::as_const(game));
+        const auto round_result = game.PlayRound(input);
+        observe(std::as_const(game));
+        if (const auto game_over = std::get_if<GameOver>(&round_result)) {
+            return *game_over;
+        }
+        if (std::holds_alternative<GameEnd>(round_result)) {
+            return game.Statistics().value();
+        }
+    }
+}
+
+template<class T, Policy<T> P>
+constexpr BatchSimulator<T, P>::BatchSimulator(P policy)
+    : policy_{std::move(policy)} {}
+
+template<class T, Policy<T> P>
+std::vector<GameOutcome> BatchSimulator<T, P>::Run(const std::span<const Seed> seeds) {
+    std::vector<GameOutcome> outcomes;
+    outcomes.reserve(seeds.size());
+    for (const auto seed : seeds) {
+        Game<T> game{T{seed}};
+        outcomes.push_back(PlayGame(game, policy_));
+    }
+    return outcomes;
+}
+
+template<class T, Policy<T> P>
+void BatchSimulator<T, P>::Run(const std::span<const Seed> seeds, const std::span<GameOutcome> outcomes) {
+    assert(seeds.size() == outcomes.size());
+    for (std::size_t index = 0; index < seeds.size(); ++index) {
+        Game<T> game{T{seeds[index]}};
+        outcomes[index] = PlayGame(game, policy_);
+    }
+}
+
+}
+
+#endif //HAMURABI_BATCH_SIMULATOR_INL
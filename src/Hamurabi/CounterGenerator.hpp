@@ -0,0 +1,55 @@
+#ifndef HAMURABI_COUNTER_GENERATOR
+#define HAMURABI_COUNTER_GENERATOR
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include "Resources.hpp"
+#include "RandomEvent.hpp"
+
+namespace hamurabi {
+
+class CounterGenerator final {
+  public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit CounterGenerator(std::uint64_t seed = 0, std::uint64_t game_id = 0) noexcept;
+
+    [[nodiscard]]
+    static constexpr result_type min() noexcept;
+
+    [[nodiscard]]
+    static constexpr result_type max() noexcept;
+
+    constexpr result_type operator()() noexcept;
+
+    constexpr void Seek(Round round, RandomEvent event) noexcept;
+
+    constexpr void discard(unsigned long long count) noexcept;
+
+    [[nodiscard]]
+    constexpr std::uint64_t Key() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::uint64_t Counter() const noexcept;
+
+    friend constexpr bool operator==(const CounterGenerator &lhs, const CounterGenerator &rhs) noexcept = default;
+
+    friend std::ostream &operator<<(std::ostream &ostream, const CounterGenerator &generator);
+
+    friend std::istream &operator>>(std::istream &istream, CounterGenerator &generator);
+
+  private:
+    [[nodiscard]]
+    static constexpr std::uint64_t Mix(std::uint64_t value) noexcept;
+
+    std::uint64_t key_;
+    std::uint64_t counter_;
+};
+
+}
+
+#include "CounterGenerator.inl"
+
+#endif //HAMURABI_COUNTER_GENERATOR
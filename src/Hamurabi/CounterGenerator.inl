@@ -0,0 +1,74 @@
+#ifndef HAMURABI_COUNTER_GENERATOR_INL
+#define HAMURABI_COUNTER_GENERATOR_INL
+
+#include <limits>
+
+namespace hamurabi {
+
+namespace detail {
+
+inline constexpr std::uint64_t kCounterGeneratorGamma = 0x9E3779B97F4A7C15;
+
+// counter is laid out as | round : 32 | event : 8 | draw : 24 |
+inline constexpr int kCounterGeneratorRoundShift = 32;
+inline constexpr int kCounterGeneratorEventShift = 24;
+
+}
+
+constexpr CounterGenerator::CounterGenerator(const std::uint64_t seed, const std::uint64_t game_id) noexcept
+    : key_{Mix(Mix(seed) ^ (game_id * detail::kCounterGeneratorGamma + detail::kCounterGeneratorGamma))},
+      counter_{0} {}
+
+constexpr CounterGenerator::result_type CounterGenerator::min() noexcept {
+    return std::numeric_limits<result_type>::min();
+}
+
+constexpr CounterGenerator::result_type CounterGenerator::max() noexcept {
+    return std::numeric_limits<result_type>::max();
+}
+
+constexpr CounterGenerator::result_type CounterGenerator::operator()() noexcept {
+    counter_ += 1;
+    return Mix(key_ + counter_ * detail::kCounterGeneratorGamma);
+}
+
+constexpr void CounterGenerator::Seek(const Round round, const RandomEvent event) noexcept {
+    counter_ = (static_cast<std::uint64_t>(round) << detail::kCounterGeneratorRoundShift) |
+        (static_cast<std::uint64_t>(event) << detail::kCounterGeneratorEventShift);
+}
+
+constexpr void CounterGenerator::discard(const unsigned long long count) noexcept {
+    counter_ += count;
+}
+
+constexpr std::uint64_t CounterGenerator::Key() const noexcept {
+    return key_;
+}
+
+constexpr std::uint64_t CounterGenerator::Counter() const noexcept {
+    return counter_;
+}
+
+// same textual form as the standard engines, so a generator state can be saved next to a game
+inline std::ostream &operator<<(std::ostream &ostream, const CounterGenerator &generator) {
+    return ostream << generator.key_ << ' ' << generator.counter_;
+}
+
+inline std::istream &operator>>(std::istream &istream, CounterGenerator &generator) {
+    CounterGenerator extracted{};
+    if (istream >> extracted.key_ >> extracted.counter_) {
+        generator = extracted;
+    }
+    return istream;
+}
+
+// SplitMix64 finalizer
+constexpr std::uint64_t CounterGenerator::Mix(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+}
+
+}
+
+#endif //HAMURABI_COUNTER_GENERATOR_INL
@@ -1,10 +1,15 @@
 #ifndef HAMURABI_DETAIL
 #define HAMURABI_DETAIL
 
+#include <span>
+#include <array>
 #include <string>
+#include <random>
 
 #include "Resources.hpp"
+#include "RandomEvent.hpp"
 #include "Serialization.hpp"
+#include "Rules.fwd"
 
 namespace hamurabi::detail {
 
@@ -24,37 +29,57 @@ extern const bool kStartIsGameOver;
 extern const Bushels kMinAcrePrice;
 extern const Bushels kMaxAcrePrice;
 
-template<class T>
-[[nodiscard("result of the next call could differ from the current result")]]
-static inline Bushels GenerateAcrePrice(T &generator);
-
 extern const Bushels kMinGrainHarvestedFromAcre;
 extern const Bushels kMaxGrainHarvestedFromAcre;
 
-template<class T>
-[[nodiscard("result of the next call could differ from the current result")]]
-static inline Bushels GenerateGrainHarvestedFromAcre(T &generator);
-
 extern const Bushels kMinGrainEatenByRatsFactor;
 extern const Bushels kMaxGrainEatenByRatsFactor;
 extern const Bushels kGrainEatenByRatsDivisor;
 
+extern const std::uint_fast16_t kMinPlaguePercent;
+extern const std::uint_fast16_t kMaxPlaguePercent;
+extern const std::uint_fast16_t kMaxPlagueCanOccurPercent;
+
+struct Distributions final {
+    std::uniform_int_distribution<Bushels> acre_price{kMinAcrePrice, kMaxAcrePrice};
+    std::uniform_int_distribution<Bushels> grain_harvested_from_acre{kMinGrainHarvestedFromAcre,
+                                                                     kMaxGrainHarvestedFromAcre};
+    std::uniform_int_distribution<Bushels> grain_eaten_by_rats{kMinGrainEatenByRatsFactor,
+                                                               kMaxGrainEatenByRatsFactor};
+    std::uniform_int_distribution<std::uint_fast16_t> plague_percent{kMinPlaguePercent, kMaxPlaguePercent};
+};
+
+template<class T>
+constexpr static inline void SeekGenerator(T &generator, Round round, RandomEvent event) noexcept;
+
+template<class T>
+[[nodiscard("result of the next call could differ from the current result")]]
+static inline Bushels GenerateAcrePrice(T &generator, Distributions &distributions);
+
 template<class T>
 [[nodiscard("result of the next call could differ from the current result")]]
-static inline Bushels GenerateGrainEatenByRats(T &generator, Bushels grain_after_harvest);
+static inline Bushels GenerateGrainHarvestedFromAcre(T &generator, Distributions &distributions);
+
+template<class T, class R = DefaultRules>
+[[nodiscard("result of the next call could differ from the current result")]]
+static inline Bushels GenerateGrainEatenByRats(T &generator, Distributions &distributions,
+                                               Bushels grain_after_harvest, const R &rules = R{});
 
 extern const Acres kAreaCanPlantWithBushel;
 
+template<class R = DefaultRules>
 [[nodiscard("result is used later to change game state")]]
-constexpr static inline Bushels GrainToPlantArea(Acres area) noexcept;
+constexpr static inline Bushels GrainToPlantArea(Acres area, const R &rules = R{}) noexcept;
 
+template<class R = DefaultRules>
 [[nodiscard("result is used later to change game state")]]
-constexpr static inline Acres AreaCanPlantWithGrain(Bushels grain) noexcept;
+constexpr static inline Acres AreaCanPlantWithGrain(Bushels grain, const R &rules = R{}) noexcept;
 
 extern const Acres kAreaToPlantPerPerson;
 
+template<class R = DefaultRules>
 [[nodiscard("result is used later to change game state")]]
-constexpr static inline Acres AreaCanPlantWithPopulation(People population) noexcept;
+constexpr static inline Acres AreaCanPlantWithPopulation(People population, const R &rules = R{}) noexcept;
 
 struct FeedPeopleResult final {
     Bushels grain_left;
@@ -63,14 +88,17 @@ struct FeedPeopleResult final {
 
 extern const Bushels kGrainPerPerson;
 
+template<class R = DefaultRules>
 [[nodiscard("result is used later to change game state")]]
-constexpr static inline FeedPeopleResult FeedPeople(People population, Bushels grain_to_feed) noexcept;
+constexpr static inline FeedPeopleResult FeedPeople(People population, Bushels grain_to_feed,
+                                                    const R &rules = R{}) noexcept;
 
 extern const People kMaxDeadFromHungerPercent;
 extern const People kMinDeadFromHungerPercentToGameOver;
 
+template<class R = DefaultRules>
 [[nodiscard("it is important to track if the game is over")]]
-constexpr static inline bool IsGameOver(People dead_from_hunger, People population) noexcept;
+constexpr static inline bool IsGameOver(People dead_from_hunger, People population, const R &rules = R{}) noexcept;
 
 using AcresSigned = std::make_signed_t<Acres>;
 using PeopleSigned = std::make_signed_t<People>;
@@ -79,16 +107,14 @@ using BushelsSigned = std::make_signed_t<Bushels>;
 extern const PeopleSigned kMinArrivedPeople;
 extern const PeopleSigned kMaxArrivedPeople;
 
+template<class R = DefaultRules>
 [[nodiscard("result is used later to change game state")]]
-constexpr static inline People CountArrivedPeople(People dead, Bushels harvested_from_acre, Bushels grain) noexcept;
-
-extern const std::uint_fast16_t kMinPlaguePercent;
-extern const std::uint_fast16_t kMaxPlaguePercent;
-extern const std::uint_fast16_t kMaxPlagueCanOccurPercent;
+constexpr static inline People CountArrivedPeople(People dead, Bushels harvested_from_acre, Bushels grain,
+                                                  const R &rules = R{}) noexcept;
 
-template<class T>
+template<class T, class R = DefaultRules>
 [[nodiscard("result of the next call could differ from the current result")]]
-static inline bool GenerateIsPlague(T &generator);
+static inline bool GenerateIsPlague(T &generator, Distributions &distributions, const R &rules = R{});
 
 static inline constexpr std::string_view TrimLeft(std::string_view string) noexcept;
 
@@ -102,6 +128,19 @@ static inline std::string &ExtractUntilTagDelim(std::istream &istream, std::stri
 
 namespace ser = hamurabi::serialization;
 
+[[nodiscard]]
+static inline constexpr std::size_t SkipSpaces(std::string_view string, std::size_t offset) noexcept;
+
+[[nodiscard]]
+static inline constexpr bool ExtractTag(std::string_view string, std::size_t &offset, std::string_view tag) noexcept;
+
+template<class U>
+[[nodiscard]]
+static inline bool ExtractNumber(std::string_view string, std::size_t &offset, U &value) noexcept;
+
+[[nodiscard]]
+static inline constexpr bool ExtractBool(std::string_view string, std::size_t &offset, bool &value) noexcept;
+
 extern const string_literal kInsertGameTag;
 extern const string_literal kInsertCurrentRoundTag;
 
@@ -171,8 +210,27 @@ static inline ser::ExtractResult ExtractIsPlague(std::istream &istream, std::str
 
 extern const string_literal kInsertTagIndent;
 
+extern const std::array<std::byte, 4> kBinaryMagic;
+extern const std::uint16_t kBinaryVersion;
+
+extern const std::size_t kBinaryFieldsOffset;
+extern const std::size_t kBinaryFlagsOffset;
+extern const std::size_t kBinaryChecksumOffset;
+
+extern const std::uint8_t kBinaryIsPlagueFlag;
+extern const std::uint8_t kBinaryIsGameOverFlag;
+
+static inline constexpr void StoreLittleEndian(std::span<std::byte> bytes, std::uint64_t value) noexcept;
+
+[[nodiscard]]
+static inline constexpr std::uint64_t LoadLittleEndian(std::span<const std::byte> bytes) noexcept;
+
+[[nodiscard]]
+static inline constexpr std::uint64_t Fnv1a(std::span<const std::byte> bytes) noexcept;
+
 }
 
 #include "Detail.inl"
+#include "Rules.hpp"
 
 #endif //HAMURABI_DETAIL
@@ -1,111 +1,130 @@
 #ifndef HAMURABI_DETAIL_INL
 #define HAMURABI_DETAIL_INL
 
+#include <bit>
 #include <random>
+#include <cstring>
+#include <charconv>
 #include <algorithm>
 
 namespace hamurabi::detail {
 
-constexpr Round kFirstRound = 1;
-constexpr Round kLastRound = 10;
+inline constexpr Round kFirstRound = 1;
+inline constexpr Round kLastRound = 10;
 
-constexpr People kStartPopulation = 100;
-constexpr Acres kStartArea = 1000;
-constexpr Bushels kStartGrain = 2800;
-constexpr People kStartDeadFromHunger = 0;
-constexpr People kStartArrived = 5;
-constexpr Bushels kStartGrainFromAcre = 3;
-constexpr Bushels kStartGrainEatenByRats = 200;
-constexpr bool kStartIsPlague = false;
-constexpr bool kStartIsGameOver = false;
+inline constexpr People kStartPopulation = 100;
+inline constexpr Acres kStartArea = 1000;
+inline constexpr Bushels kStartGrain = 2800;
+inline constexpr People kStartDeadFromHunger = 0;
+inline constexpr People kStartArrived = 5;
+inline constexpr Bushels kStartGrainFromAcre = 3;
+inline constexpr Bushels kStartGrainEatenByRats = 200;
+inline constexpr bool kStartIsPlague = false;
+inline constexpr bool kStartIsGameOver = false;
 
-constexpr Bushels kMinAcrePrice = 17;
-constexpr Bushels kMaxAcrePrice = 26;
+inline constexpr Bushels kMinAcrePrice = 17;
+inline constexpr Bushels kMaxAcrePrice = 26;
 
 template<class T>
-Bushels GenerateAcrePrice(T &generator) {
-    static std::uniform_int_distribution<Bushels> distribution{kMinAcrePrice, kMaxAcrePrice};
-    return distribution(generator);
+constexpr void SeekGenerator(T &generator, const Round round, const RandomEvent event) noexcept {
+    if constexpr (requires { generator.Seek(round, event); }) {
+        generator.Seek(round, event);
+    }
 }
 
-constexpr Bushels kMinGrainHarvestedFromAcre = 1;
-constexpr Bushels kMaxGrainHarvestedFromAcre = 6;
-
 template<class T>
-Bushels GenerateGrainHarvestedFromAcre(T &generator) {
-    static std::uniform_int_distribution<Bushels> distribution{kMinGrainHarvestedFromAcre, kMaxGrainHarvestedFromAcre};
-    return distribution(generator);
+Bushels GenerateAcrePrice(T &generator, Distributions &distributions) {
+    return distributions.acre_price(generator);
 }
 
-constexpr Bushels kMinGrainEatenByRatsFactor = 0;
-constexpr Bushels kMaxGrainEatenByRatsFactor = 7;
-constexpr Bushels kGrainEatenByRatsDivisor = 100;
+inline constexpr Bushels kMinGrainHarvestedFromAcre = 1;
+inline constexpr Bushels kMaxGrainHarvestedFromAcre = 6;
 
 template<class T>
-Bushels GenerateGrainEatenByRats(T &generator, const Bushels grain_after_harvest) {
-    static std::uniform_int_distribution<Bushels> distribution{kMinGrainEatenByRatsFactor, kMaxGrainEatenByRatsFactor};
-    const auto generated_value = distribution(generator);
-    return (grain_after_harvest * generated_value) / kGrainEatenByRatsDivisor;
+Bushels GenerateGrainHarvestedFromAcre(T &generator, Distributions &distributions) {
+    return distributions.grain_harvested_from_acre(generator);
+}
+
+inline constexpr Bushels kMinGrainEatenByRatsFactor = 0;
+inline constexpr Bushels kMaxGrainEatenByRatsFactor = 7;
+inline constexpr Bushels kGrainEatenByRatsDivisor = 100;
+
+template<class T, class R>
+Bushels GenerateGrainEatenByRats(T &generator, Distributions &distributions, const Bushels grain_after_harvest,
+                                 const R &rules) {
+    const auto generated_value = distributions.grain_eaten_by_rats(generator);
+    return (grain_after_harvest * generated_value) / rules.GrainEatenByRatsDivisor();
 }
 
-constexpr Acres kAreaCanPlantWithBushel = 2;
+inline constexpr Acres kAreaCanPlantWithBushel = 2;
 
-constexpr Bushels GrainToPlantArea(const Acres area) noexcept {
-    return area / kAreaCanPlantWithBushel;
+template<class R>
+constexpr Bushels GrainToPlantArea(const Acres area, const R &rules) noexcept {
+    return area / rules.AreaCanPlantWithBushel();
 }
 
-constexpr Acres AreaCanPlantWithGrain(const Bushels grain) noexcept {
-    return grain * kAreaCanPlantWithBushel;
+template<class R>
+constexpr Acres AreaCanPlantWithGrain(const Bushels grain, const R &rules) noexcept {
+    return grain * rules.AreaCanPlantWithBushel();
 }
 
-constexpr Acres kAreaToPlantPerPerson = 10;
+inline constexpr Acres kAreaToPlantPerPerson = 10;
 
-constexpr Acres AreaCanPlantWithPopulation(const People population) noexcept {
-    return population * kAreaToPlantPerPerson;
+template<class R>
+constexpr Acres AreaCanPlantWithPopulation(const People population, const R &rules) noexcept {
+    return population * rules.AreaToPlantPerPerson();
 }
 
-constexpr Bushels kGrainPerPerson = 20;
+inline constexpr Bushels kGrainPerPerson = 20;
 
-constexpr FeedPeopleResult FeedPeople(const People population, const Bushels grain_to_feed) noexcept {
-    const auto needed_grain = population * kGrainPerPerson;
+template<class R>
+constexpr FeedPeopleResult FeedPeople(const People population, const Bushels grain_to_feed, const R &rules) noexcept {
+    const auto grain_per_person = rules.GrainPerPerson();
+    const auto needed_grain = population * grain_per_person;
     if (needed_grain > grain_to_feed) {
-        const auto dead = (needed_grain - grain_to_feed - 1) / kGrainPerPerson + 1;
+        const auto dead = (needed_grain - grain_to_feed - 1) / grain_per_person + 1;
         return {.grain_left = 0, .dead = dead};
     }
     const auto grain_left = grain_to_feed - needed_grain;
     return {.grain_left = grain_left, .dead = 0};
 }
 
-constexpr People kMaxDeadFromHungerPercent = 100;
-constexpr People kMinDeadFromHungerPercentToGameOver = 45;
+inline constexpr People kMaxDeadFromHungerPercent = 100;
+inline constexpr People kMinDeadFromHungerPercentToGameOver = 45;
 
-constexpr bool IsGameOver(const People dead_from_hunger, const People population) noexcept {
+template<class R>
+constexpr bool IsGameOver(const People dead_from_hunger, const People population, const R &rules) noexcept {
+    // a plague can halve the last person away, nobody is left to rule then
+    if (population == 0) {
+        return true;
+    }
     const auto percentage = (dead_from_hunger * kMaxDeadFromHungerPercent) / population;
-    return percentage > kMinDeadFromHungerPercentToGameOver;
+    return percentage > rules.MinDeadFromHungerPercentToGameOver();
 }
 
-constexpr PeopleSigned kMinArrivedPeople = 0;
-constexpr PeopleSigned kMaxArrivedPeople = 50;
+inline constexpr PeopleSigned kMinArrivedPeople = 0;
+inline constexpr PeopleSigned kMaxArrivedPeople = 50;
 
+template<class R>
 constexpr People CountArrivedPeople(const People dead,
                                     const Bushels harvested_from_acre,
-                                    const Bushels grain) noexcept {
+                                    const Bushels grain,
+                                    const R &rules) noexcept {
     const auto dead_signed = static_cast<PeopleSigned>(dead);
     const auto harvested_from_acre_signed = static_cast<BushelsSigned>(harvested_from_acre);
     const auto grain_signed = static_cast<BushelsSigned>(grain);
     const auto calculation = (dead_signed / 2) + ((5 - harvested_from_acre_signed) * grain_signed / 600) + 1;
-    const auto clamped = std::clamp(calculation, kMinArrivedPeople, kMaxArrivedPeople);
+    const auto clamped = std::clamp(calculation, rules.MinArrivedPeople(), rules.MaxArrivedPeople());
     return static_cast<People>(clamped);
 }
 
-constexpr std::uint_fast16_t kMinPlaguePercent = 0;
-constexpr std::uint_fast16_t kMaxPlaguePercent = 100;
-constexpr std::uint_fast16_t kMaxPlagueCanOccurPercent = 15;
+inline constexpr std::uint_fast16_t kMinPlaguePercent = 0;
+inline constexpr std::uint_fast16_t kMaxPlaguePercent = 100;
+inline constexpr std::uint_fast16_t kMaxPlagueCanOccurPercent = 15;
 
-template<class T>
-bool GenerateIsPlague(T &generator) {
-    static std::uniform_int_distribution distribution{kMinPlaguePercent, kMaxPlaguePercent};
-    return distribution(generator) <= kMaxPlagueCanOccurPercent;
+template<class T, class R>
+bool GenerateIsPlague(T &generator, Distributions &distributions, const R &rules) {
+    return distributions.plague_percent(generator) <= rules.MaxPlagueCanOccurPercent();
 }
 
 static inline bool TrimPredicate(const unsigned char character) noexcept {
@@ -132,7 +151,7 @@ constexpr std::string_view Trim(const std::string_view string) noexcept {
     return TrimLeft(TrimRight(string));
 }
 
-constexpr char kInsertTagDelim = ':';
+inline constexpr char kInsertTagDelim = ':';
 
 std::string &ExtractUntilTagDelim(std::istream &istream, std::string &buffer) {
     buffer.clear();
@@ -141,8 +160,54 @@ std::string &ExtractUntilTagDelim(std::istream &istream, std::string &buffer) {
     return buffer;
 }
 
-constexpr string_literal kInsertGameTag = "hamurabi";
-constexpr string_literal kInsertCurrentRoundTag = "current_round";
+constexpr std::size_t SkipSpaces(const std::string_view string, const std::size_t offset) noexcept {
+    auto first = offset;
+    while (first < string.size() && (string[first] == ' ' || (string[first] >= '\t' && string[first] <= '\r'))) {
+        first += 1;
+    }
+    return first;
+}
+
+constexpr bool ExtractTag(const std::string_view string, std::size_t &offset, const std::string_view tag) noexcept {
+    offset = SkipSpaces(string, offset);
+    const auto delim = string.find(kInsertTagDelim, offset);
+    if (delim == std::string_view::npos || TrimRight(string.substr(offset, delim - offset)) != tag) {
+        return false;
+    }
+    offset = delim + 1;
+    return true;
+}
+
+template<class U>
+bool ExtractNumber(const std::string_view string, std::size_t &offset, U &value) noexcept {
+    offset = SkipSpaces(string, offset);
+    const auto last = string.data() + string.size();
+    const auto [end, error] = std::from_chars(string.data() + offset, last, value);
+    if (error != std::errc{}) {
+        return false;
+    }
+    offset = static_cast<std::size_t>(end - string.data());
+    return true;
+}
+
+constexpr bool ExtractBool(const std::string_view string, std::size_t &offset, bool &value) noexcept {
+    using namespace std::string_view_literals;
+    offset = SkipSpaces(string, offset);
+    const auto rest = string.substr(offset);
+    for (const auto &[literal, literal_value] : {std::pair{"true"sv, true}, std::pair{"false"sv, false}}) {
+        // the literal must be a whole word, "trueX" is no bool
+        const auto is_word_end = rest.size() == literal.size() || SkipSpaces(rest, literal.size()) != literal.size();
+        if (rest.starts_with(literal) && is_word_end) {
+            value = literal_value;
+            offset += literal.size();
+            return true;
+        }
+    }
+    return false;
+}
+
+inline constexpr string_literal kInsertGameTag = "hamurabi";
+inline constexpr string_literal kInsertCurrentRoundTag = "current_round";
 
 ser::ExtractResult ExtractCurrentRound(std::istream &istream, std::string &buffer,
                                        Round &current_round, [[maybe_unused]] const ser::Format format) {
@@ -155,7 +220,7 @@ ser::ExtractResult ExtractCurrentRound(std::istream &istream, std::string &buffe
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertPopulationTag = "population";
+inline constexpr string_literal kInsertPopulationTag = "population";
 
 ser::ExtractResult ExtractPopulation(std::istream &istream, std::string &buffer,
                                      People &population, [[maybe_unused]] const ser::Format format) {
@@ -167,7 +232,7 @@ ser::ExtractResult ExtractPopulation(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertAreaTag = "area";
+inline constexpr string_literal kInsertAreaTag = "area";
 
 ser::ExtractResult ExtractArea(std::istream &istream, std::string &buffer,
                                Acres &area, [[maybe_unused]] const ser::Format format) {
@@ -179,7 +244,7 @@ ser::ExtractResult ExtractArea(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertGrainTag = "grain";
+inline constexpr string_literal kInsertGrainTag = "grain";
 
 ser::ExtractResult ExtractGrain(std::istream &istream, std::string &buffer,
                                 Bushels &grain, [[maybe_unused]] const ser::Format format) {
@@ -191,7 +256,7 @@ ser::ExtractResult ExtractGrain(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertAcrePriceTag = "acre_price";
+inline constexpr string_literal kInsertAcrePriceTag = "acre_price";
 
 ser::ExtractResult ExtractAcrePrice(std::istream &istream, std::string &buffer,
                                     Bushels &acre_price, [[maybe_unused]] const ser::Format format) {
@@ -203,7 +268,7 @@ ser::ExtractResult ExtractAcrePrice(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertDeadFromHungerTag = "dead_from_hunger";
+inline constexpr string_literal kInsertDeadFromHungerTag = "dead_from_hunger";
 
 ser::ExtractResult ExtractDeadFromHunger(std::istream &istream, std::string &buffer,
                                          People &dead_from_hunger, [[maybe_unused]] const ser::Format format) {
@@ -215,7 +280,7 @@ ser::ExtractResult ExtractDeadFromHunger(std::istream &istream, std::string &buf
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertDeadFromHungerInTotalTag = "dead_from_hunger_in_total";
+inline constexpr string_literal kInsertDeadFromHungerInTotalTag = "dead_from_hunger_in_total";
 
 ser::ExtractResult ExtractDeadFromHungerInTotal(std::istream &istream, std::string &buffer,
                                                 People &dead_in_total, [[maybe_unused]] const ser::Format format) {
@@ -227,7 +292,7 @@ ser::ExtractResult ExtractDeadFromHungerInTotal(std::istream &istream, std::stri
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertArrivedTag = "arrived";
+inline constexpr string_literal kInsertArrivedTag = "arrived";
 
 ser::ExtractResult ExtractArrived(std::istream &istream, std::string &buffer,
                                   People &arrived, [[maybe_unused]] const ser::Format format) {
@@ -239,7 +304,7 @@ ser::ExtractResult ExtractArrived(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertGrainFromAcreTag = "grain_from_acre";
+inline constexpr string_literal kInsertGrainFromAcreTag = "grain_from_acre";
 
 ser::ExtractResult ExtractGrainFromAcre(std::istream &istream, std::string &buffer,
                                         Bushels &grain_from_acre, [[maybe_unused]] const ser::Format format) {
@@ -251,7 +316,7 @@ ser::ExtractResult ExtractGrainFromAcre(std::istream &istream, std::string &buff
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertGrainEatenByRatsTag = "grain_eaten_by_rats";
+inline constexpr string_literal kInsertGrainEatenByRatsTag = "grain_eaten_by_rats";
 
 ser::ExtractResult ExtractGrainEatenByRats(std::istream &istream, std::string &buffer,
                                            Bushels &grain_eaten_by_rats, [[maybe_unused]] const ser::Format format) {
@@ -263,7 +328,7 @@ ser::ExtractResult ExtractGrainEatenByRats(std::istream &istream, std::string &b
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertIsPlagueTag = "is_plague";
+inline constexpr string_literal kInsertIsPlagueTag = "is_plague";
 
 ser::ExtractResult ExtractIsPlague(std::istream &istream, std::string &buffer,
                                    bool &is_plague, [[maybe_unused]] const ser::Format format) {
@@ -275,7 +340,52 @@ ser::ExtractResult ExtractIsPlague(std::istream &istream, std::string &buffer,
     return ser::ExtractResult::Success;
 }
 
-constexpr string_literal kInsertTagIndent = "    ";
+inline constexpr string_literal kInsertTagIndent = "    ";
+
+inline constexpr std::array<std::byte, 4> kBinaryMagic = {std::byte{'H'}, std::byte{'M'}, std::byte{'R'}, std::byte{'B'}};
+inline constexpr std::uint16_t kBinaryVersion = 1;
+
+inline constexpr std::size_t kBinaryFieldsOffset = 8;
+inline constexpr std::size_t kBinaryFlagsOffset = kBinaryFieldsOffset + 10 * 8;
+inline constexpr std::size_t kBinaryChecksumOffset = kBinaryFlagsOffset + 8;
+
+inline constexpr std::uint8_t kBinaryIsPlagueFlag = 1 << 0;
+inline constexpr std::uint8_t kBinaryIsGameOverFlag = 1 << 1;
+
+constexpr void StoreLittleEndian(const std::span<std::byte> bytes, std::uint64_t value) noexcept {
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little && bytes.size() == 8) {
+        std::memcpy(bytes.data(), &value, sizeof(value));
+        return;
+    }
+    for (auto &byte : bytes) {
+        byte = static_cast<std::byte>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+constexpr std::uint64_t LoadLittleEndian(const std::span<const std::byte> bytes) noexcept {
+    std::uint64_t value = 0;
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little && bytes.size() == 8) {
+        std::memcpy(&value, bytes.data(), sizeof(value));
+        return value;
+    }
+    for (auto byte = bytes.rbegin(); byte != bytes.rend(); ++byte) {
+        value = (value << 8) | std::to_integer<std::uint64_t>(*byte);
+    }
+    return value;
+}
+
+// fnv-1a taken a little-endian word at a time, the byte-wise chain of multiplications costs more than the rest
+constexpr std::uint64_t Fnv1a(std::span<const std::byte> bytes) noexcept {
+    std::uint64_t hash = 0xCBF29CE484222325;
+    while (!bytes.empty()) {
+        const auto word = bytes.first(std::min<std::size_t>(8, bytes.size()));
+        hash ^= LoadLittleEndian(word);
+        hash *= 0x100000001B3;
+        bytes = bytes.subspan(word.size());
+    }
+    return hash;
+}
 
 }
 
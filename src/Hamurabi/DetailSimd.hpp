@@ -0,0 +1,55 @@
+#ifndef HAMURABI_DETAIL_SIMD
+#define HAMURABI_DETAIL_SIMD
+
+#include <span>
+
+#include "Detail.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define HAMURABI_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define HAMURABI_SIMD_X86 0
+#endif
+
+namespace hamurabi::detail::simd {
+
+enum class Isa : std::uint8_t {
+    Scalar,
+    Sse42,
+    Avx2,
+};
+
+[[nodiscard]]
+static inline Isa SupportedIsa() noexcept;
+
+static inline void FeedPeople(Isa isa,
+                              std::span<const People> population, std::span<const Bushels> grain_to_feed,
+                              std::span<Bushels> grain_left, std::span<People> dead) noexcept;
+
+static inline void FeedPeople(std::span<const People> population, std::span<const Bushels> grain_to_feed,
+                              std::span<Bushels> grain_left, std::span<People> dead) noexcept;
+
+static inline void IsGameOver(Isa isa,
+                              std::span<const People> dead_from_hunger, std::span<const People> population,
+                              std::span<std::uint8_t> is_game_over) noexcept;
+
+static inline void IsGameOver(std::span<const People> dead_from_hunger, std::span<const People> population,
+                              std::span<std::uint8_t> is_game_over) noexcept;
+
+static inline void CountArrivedPeople(Isa isa,
+                                      std::span<const People> dead, std::span<const Bushels> harvested_from_acre,
+                                      std::span<const Bushels> grain, std::span<People> arrived) noexcept;
+
+static inline void CountArrivedPeople(std::span<const People> dead, std::span<const Bushels> harvested_from_acre,
+                                      std::span<const Bushels> grain, std::span<People> arrived) noexcept;
+
+static inline void GrainToPlantArea(Isa isa, std::span<const Acres> area, std::span<Bushels> grain) noexcept;
+
+static inline void GrainToPlantArea(std::span<const Acres> area, std::span<Bushels> grain) noexcept;
+
+}
+
+#include "DetailSimd.inl"
+
+#endif //HAMURABI_DETAIL_SIMD
@@ -0,0 +1,438 @@
+#ifndef HAMURABI_DETAIL_SIMD_INL
+#define HAMURABI_DETAIL_SIMD_INL
+
+#include <cassert>
+
+namespace hamurabi::detail::simd {
+
+// vector kernels keep one game per 64-bit lane and work in 32-bit products,
+// so a block with any value outside of that domain is handed to the scalar code
+inline constexpr bool kHasVectorLayout = sizeof(People) == sizeof(std::uint64_t) &&
+    sizeof(Acres) == sizeof(std::uint64_t) &&
+    sizeof(Bushels) == sizeof(std::uint64_t);
+
+// x / 20 == (x * kDivideBy20Magic) >> kDivideBy20Shift for every 32-bit x
+inline constexpr std::uint64_t kDivideBy20Magic = 0xCCCCCCCD;
+inline constexpr int kDivideBy20Shift = 36;
+
+// x / 600 == (x * kDivideBy600Magic) >> kDivideBy600Shift for every 32-bit x
+inline constexpr std::uint64_t kDivideBy600Magic = 0x1B4E81B5;
+inline constexpr int kDivideBy600Shift = 38;
+
+static_assert(kGrainPerPerson == 20);
+static_assert(kMaxDeadFromHungerPercent == 100);
+static_assert(kMinDeadFromHungerPercentToGameOver == 45);
+static_assert(kAreaCanPlantWithBushel == 2);
+static_assert(kMinArrivedPeople == 0 && kMaxArrivedPeople == 50);
+
+inline constexpr std::uint64_t kFeedPopulationLimit = std::uint64_t{1} << 27;
+inline constexpr std::uint64_t kSignBit = std::uint64_t{1} << 63;
+inline constexpr std::uint64_t kHigh32Bits = ~std::uint64_t{0} << 32;
+inline constexpr std::uint64_t kArrivedHarvestLimit = 16;
+inline constexpr std::uint64_t kArrivedGrainLimit = std::uint64_t{1} << 28;
+
+static inline void FeedPeopleScalar(const std::span<const People> population,
+                                    const std::span<const Bushels> grain_to_feed,
+                                    const std::span<Bushels> grain_left, const std::span<People> dead,
+                                    const std::size_t first, const std::size_t last) noexcept {
+    for (auto index = first; index < last; ++index) {
+        const auto result = detail::FeedPeople(population[index], grain_to_feed[index]);
+        grain_left[index] = result.grain_left;
+        dead[index] = result.dead;
+    }
+}
+
+static inline void IsGameOverScalar(const std::span<const People> dead_from_hunger,
+                                    const std::span<const People> population,
+                                    const std::span<std::uint8_t> is_game_over,
+                                    const std::size_t first, const std::size_t last) noexcept {
+    for (auto index = first; index < last; ++index) {
+        is_game_over[index] = detail::IsGameOver(dead_from_hunger[index], population[index]);
+    }
+}
+
+static inline void CountArrivedPeopleScalar(const std::span<const People> dead,
+                                            const std::span<const Bushels> harvested_from_acre,
+                                            const std::span<const Bushels> grain, const std::span<People> arrived,
+                                            const std::size_t first, const std::size_t last) noexcept {
+    for (auto index = first; index < last; ++index) {
+        arrived[index] = detail::CountArrivedPeople(dead[index], harvested_from_acre[index], grain[index]);
+    }
+}
+
+static inline void GrainToPlantAreaScalar(const std::span<const Acres> area, const std::span<Bushels> grain,
+                                          const std::size_t first, const std::size_t last) noexcept {
+    for (auto index = first; index < last; ++index) {
+        grain[index] = detail::GrainToPlantArea(area[index]);
+    }
+}
+
+#if HAMURABI_SIMD_X86
+
+__attribute__((target("sse4.2")))
+static inline __m128i LoadSse42(const void *data, const std::size_t index) noexcept {
+    return _mm_loadu_si128(static_cast<const __m128i *>(data) + index / 2);
+}
+
+__attribute__((target("sse4.2")))
+static inline void StoreSse42(void *data, const std::size_t index, const __m128i value) noexcept {
+    _mm_storeu_si128(static_cast<__m128i *>(data) + index / 2, value);
+}
+
+__attribute__((target("sse4.2")))
+static inline void FeedPeopleSse42(const std::span<const People> population,
+                                   const std::span<const Bushels> grain_to_feed,
+                                   const std::span<Bushels> grain_left, const std::span<People> dead) noexcept {
+    const auto size = population.size();
+    const auto out_of_domain = _mm_set1_epi64x(static_cast<long long>(~(kFeedPopulationLimit - 1)));
+    const auto sign_bit = _mm_set1_epi64x(static_cast<long long>(kSignBit));
+    const auto grain_per_person = _mm_set1_epi64x(kGrainPerPerson);
+    const auto magic = _mm_set1_epi64x(kDivideBy20Magic);
+    const auto one = _mm_set1_epi64x(1);
+    std::size_t index = 0;
+    for (; index + 2 <= size; index += 2) {
+        const auto people = LoadSse42(population.data(), index);
+        const auto feed = LoadSse42(grain_to_feed.data(), index);
+        const auto domain = _mm_or_si128(_mm_and_si128(people, out_of_domain), _mm_and_si128(feed, sign_bit));
+        if (!_mm_testz_si128(domain, domain)) {
+            FeedPeopleScalar(population, grain_to_feed, grain_left, dead, index, index + 2);
+            continue;
+        }
+        const auto needed = _mm_mul_epu32(people, grain_per_person);
+        const auto is_starving = _mm_cmpgt_epi64(needed, feed);
+        const auto deficit = _mm_sub_epi64(_mm_sub_epi64(needed, feed), one);
+        const auto starved = _mm_add_epi64(_mm_srli_epi64(_mm_mul_epu32(deficit, magic), kDivideBy20Shift), one);
+        StoreSse42(dead.data(), index, _mm_and_si128(is_starving, starved));
+        StoreSse42(grain_left.data(), index, _mm_andnot_si128(is_starving, _mm_sub_epi64(feed, needed)));
+    }
+    FeedPeopleScalar(population, grain_to_feed, grain_left, dead, index, size);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i LoadAvx2(const void *data, const std::size_t index) noexcept {
+    return _mm256_loadu_si256(static_cast<const __m256i *>(data) + index / 4);
+}
+
+__attribute__((target("avx2")))
+static inline void StoreAvx2(void *data, const std::size_t index, const __m256i value) noexcept {
+    _mm256_storeu_si256(static_cast<__m256i *>(data) + index / 4, value);
+}
+
+__attribute__((target("avx2")))
+static inline void FeedPeopleAvx2(const std::span<const People> population,
+                                  const std::span<const Bushels> grain_to_feed,
+                                  const std::span<Bushels> grain_left, const std::span<People> dead) noexcept {
+    const auto size = population.size();
+    const auto out_of_domain = _mm256_set1_epi64x(static_cast<long long>(~(kFeedPopulationLimit - 1)));
+    const auto sign_bit = _mm256_set1_epi64x(static_cast<long long>(kSignBit));
+    const auto grain_per_person = _mm256_set1_epi64x(kGrainPerPerson);
+    const auto magic = _mm256_set1_epi64x(kDivideBy20Magic);
+    const auto one = _mm256_set1_epi64x(1);
+    std::size_t index = 0;
+    for (; index + 4 <= size; index += 4) {
+        const auto people = LoadAvx2(population.data(), index);
+        const auto feed = LoadAvx2(grain_to_feed.data(), index);
+        const auto domain = _mm256_or_si256(_mm256_and_si256(people, out_of_domain),
+                                            _mm256_and_si256(feed, sign_bit));
+        if (!_mm256_testz_si256(domain, domain)) {
+            FeedPeopleScalar(population, grain_to_feed, grain_left, dead, index, index + 4);
+            continue;
+        }
+        const auto needed = _mm256_mul_epu32(people, grain_per_person);
+        const auto is_starving = _mm256_cmpgt_epi64(needed, feed);
+        const auto deficit = _mm256_sub_epi64(_mm256_sub_epi64(needed, feed), one);
+        const auto starved = _mm256_add_epi64(
+            _mm256_srli_epi64(_mm256_mul_epu32(deficit, magic), kDivideBy20Shift), one);
+        StoreAvx2(dead.data(), index, _mm256_and_si256(is_starving, starved));
+        StoreAvx2(grain_left.data(), index, _mm256_andnot_si256(is_starving, _mm256_sub_epi64(feed, needed)));
+    }
+    FeedPeopleScalar(population, grain_to_feed, grain_left, dead, index, size);
+}
+
+__attribute__((target("sse4.2")))
+static inline void IsGameOverSse42(const std::span<const People> dead_from_hunger,
+                                   const std::span<const People> population,
+                                   const std::span<std::uint8_t> is_game_over) noexcept {
+    const auto size = population.size();
+    const auto high_bits = _mm_set1_epi64x(static_cast<long long>(kHigh32Bits));
+    const auto max_percent = _mm_set1_epi64x(kMaxDeadFromHungerPercent);
+    const auto min_percent = _mm_set1_epi64x(kMinDeadFromHungerPercentToGameOver + 1);
+    std::size_t index = 0;
+    for (; index + 2 <= size; index += 2) {
+        const auto dead = LoadSse42(dead_from_hunger.data(), index);
+        const auto people = LoadSse42(population.data(), index);
+        const auto is_empty = _mm_cmpeq_epi64(people, _mm_setzero_si128());
+        const auto domain = _mm_or_si128(_mm_and_si128(_mm_or_si128(dead, people), high_bits), is_empty);
+        if (!_mm_testz_si128(domain, domain)) {
+            IsGameOverScalar(dead_from_hunger, population, is_game_over, index, index + 2);
+            continue;
+        }
+        // (dead * 100) / population > 45 is dead * 100 >= population * 46 for positive population
+        const auto is_not_over = _mm_cmpgt_epi64(_mm_mul_epu32(people, min_percent),
+                                                 _mm_mul_epu32(dead, max_percent));
+        const auto mask = ~_mm_movemask_pd(_mm_castsi128_pd(is_not_over));
+        is_game_over[index] = mask & 1;
+        is_game_over[index + 1] = (mask >> 1) & 1;
+    }
+    IsGameOverScalar(dead_from_hunger, population, is_game_over, index, size);
+}
+
+__attribute__((target("avx2")))
+static inline void IsGameOverAvx2(const std::span<const People> dead_from_hunger,
+                                  const std::span<const People> population,
+                                  const std::span<std::uint8_t> is_game_over) noexcept {
+    const auto size = population.size();
+    const auto high_bits = _mm256_set1_epi64x(static_cast<long long>(kHigh32Bits));
+    const auto max_percent = _mm256_set1_epi64x(kMaxDeadFromHungerPercent);
+    const auto min_percent = _mm256_set1_epi64x(kMinDeadFromHungerPercentToGameOver + 1);
+    std::size_t index = 0;
+    for (; index + 4 <= size; index += 4) {
+        const auto dead = LoadAvx2(dead_from_hunger.data(), index);
+        const auto people = LoadAvx2(population.data(), index);
+        const auto is_empty = _mm256_cmpeq_epi64(people, _mm256_setzero_si256());
+        const auto domain = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(dead, people), high_bits), is_empty);
+        if (!_mm256_testz_si256(domain, domain)) {
+            IsGameOverScalar(dead_from_hunger, population, is_game_over, index, index + 4);
+            continue;
+        }
+        const auto is_not_over = _mm256_cmpgt_epi64(_mm256_mul_epu32(people, min_percent),
+                                                    _mm256_mul_epu32(dead, max_percent));
+        const auto mask = ~_mm256_movemask_pd(_mm256_castsi256_pd(is_not_over));
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            is_game_over[index + lane] = (mask >> lane) & 1;
+        }
+    }
+    IsGameOverScalar(dead_from_hunger, population, is_game_over, index, size);
+}
+
+__attribute__((target("sse4.2")))
+static inline void CountArrivedPeopleSse42(const std::span<const People> dead,
+                                           const std::span<const Bushels> harvested_from_acre,
+                                           const std::span<const Bushels> grain,
+                                           const std::span<People> arrived) noexcept {
+    const auto size = dead.size();
+    const auto dead_domain = _mm_set1_epi64x(static_cast<long long>(kHigh32Bits));
+    const auto harvest_domain = _mm_set1_epi64x(static_cast<long long>(~(kArrivedHarvestLimit - 1)));
+    const auto grain_domain = _mm_set1_epi64x(static_cast<long long>(~(kArrivedGrainLimit - 1)));
+    const auto five = _mm_set1_epi64x(5);
+    const auto magic = _mm_set1_epi64x(kDivideBy600Magic);
+    const auto zero = _mm_setzero_si128();
+    const auto one = _mm_set1_epi64x(1);
+    const auto max_arrived = _mm_set1_epi64x(kMaxArrivedPeople);
+    std::size_t index = 0;
+    for (; index + 2 <= size; index += 2) {
+        const auto people = LoadSse42(dead.data(), index);
+        const auto harvest = LoadSse42(harvested_from_acre.data(), index);
+        const auto bushels = LoadSse42(grain.data(), index);
+        const auto domain = _mm_or_si128(_mm_and_si128(people, dead_domain),
+                                         _mm_or_si128(_mm_and_si128(harvest, harvest_domain),
+                                                      _mm_and_si128(bushels, grain_domain)));
+        if (!_mm_testz_si128(domain, domain)) {
+            CountArrivedPeopleScalar(dead, harvested_from_acre, grain, arrived, index, index + 2);
+            continue;
+        }
+        const auto is_negative = _mm_cmpgt_epi64(harvest, five);
+        const auto factor = _mm_blendv_epi8(_mm_sub_epi64(five, harvest), _mm_sub_epi64(harvest, five), is_negative);
+        const auto quotient = _mm_srli_epi64(_mm_mul_epu32(_mm_mul_epu32(factor, bushels), magic),
+                                             kDivideBy600Shift);
+        const auto signed_quotient = _mm_blendv_epi8(quotient, _mm_sub_epi64(zero, quotient), is_negative);
+        auto calculation = _mm_add_epi64(_mm_add_epi64(_mm_srli_epi64(people, 1), signed_quotient), one);
+        calculation = _mm_blendv_epi8(calculation, zero, _mm_cmpgt_epi64(zero, calculation));
+        calculation = _mm_blendv_epi8(calculation, max_arrived, _mm_cmpgt_epi64(calculation, max_arrived));
+        StoreSse42(arrived.data(), index, calculation);
+    }
+    CountArrivedPeopleScalar(dead, harvested_from_acre, grain, arrived, index, size);
+}
+
+__attribute__((target("avx2")))
+static inline void CountArrivedPeopleAvx2(const std::span<const People> dead,
+                                          const std::span<const Bushels> harvested_from_acre,
+                                          const std::span<const Bushels> grain,
+                                          const std::span<People> arrived) noexcept {
+    const auto size = dead.size();
+    const auto dead_domain = _mm256_set1_epi64x(static_cast<long long>(kHigh32Bits));
+    const auto harvest_domain = _mm256_set1_epi64x(static_cast<long long>(~(kArrivedHarvestLimit - 1)));
+    const auto grain_domain = _mm256_set1_epi64x(static_cast<long long>(~(kArrivedGrainLimit - 1)));
+    const auto five = _mm256_set1_epi64x(5);
+    const auto magic = _mm256_set1_epi64x(kDivideBy600Magic);
+    const auto zero = _mm256_setzero_si256();
+    const auto one = _mm256_set1_epi64x(1);
+    const auto max_arrived = _mm256_set1_epi64x(kMaxArrivedPeople);
+    std::size_t index = 0;
+    for (; index + 4 <= size; index += 4) {
+        const auto people = LoadAvx2(dead.data(), index);
+        const auto harvest = LoadAvx2(harvested_from_acre.data(), index);
+        const auto bushels = LoadAvx2(grain.data(), index);
+        const auto domain = _mm256_or_si256(_mm256_and_si256(people, dead_domain),
+                                            _mm256_or_si256(_mm256_and_si256(harvest, harvest_domain),
+                                                            _mm256_and_si256(bushels, grain_domain)));
+        if (!_mm256_testz_si256(domain, domain)) {
+            CountArrivedPeopleScalar(dead, harvested_from_acre, grain, arrived, index, index + 4);
+            continue;
+        }
+        const auto is_negative = _mm256_cmpgt_epi64(harvest, five);
+        const auto factor = _mm256_blendv_epi8(_mm256_sub_epi64(five, harvest),
+                                               _mm256_sub_epi64(harvest, five), is_negative);
+        const auto quotient = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_mul_epu32(factor, bushels), magic),
+                                                kDivideBy600Shift);
+        const auto signed_quotient = _mm256_blendv_epi8(quotient, _mm256_sub_epi64(zero, quotient), is_negative);
+        auto calculation = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(people, 1), signed_quotient), one);
+        calculation = _mm256_blendv_epi8(calculation, zero, _mm256_cmpgt_epi64(zero, calculation));
+        calculation = _mm256_blendv_epi8(calculation, max_arrived, _mm256_cmpgt_epi64(calculation, max_arrived));
+        StoreAvx2(arrived.data(), index, calculation);
+    }
+    CountArrivedPeopleScalar(dead, harvested_from_acre, grain, arrived, index, size);
+}
+
+__attribute__((target("sse4.2")))
+static inline void GrainToPlantAreaSse42(const std::span<const Acres> area, const std::span<Bushels> grain) noexcept {
+    const auto size = area.size();
+    std::size_t index = 0;
+    for (; index + 2 <= size; index += 2) {
+        StoreSse42(grain.data(), index, _mm_srli_epi64(LoadSse42(area.data(), index), 1));
+    }
+    GrainToPlantAreaScalar(area, grain, index, size);
+}
+
+__attribute__((target("avx2")))
+static inline void GrainToPlantAreaAvx2(const std::span<const Acres> area, const std::span<Bushels> grain) noexcept {
+    const auto size = area.size();
+    std::size_t index = 0;
+    for (; index + 4 <= size; index += 4) {
+        StoreAvx2(grain.data(), index, _mm256_srli_epi64(LoadAvx2(area.data(), index), 1));
+    }
+    GrainToPlantAreaScalar(area, grain, index, size);
+}
+
+#endif
+
+Isa SupportedIsa() noexcept {
+    static const Isa isa = []() noexcept {
+        if constexpr (!kHasVectorLayout) {
+            return Isa::Scalar;
+        }
+#if HAMURABI_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Isa::Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return Isa::Sse42;
+        }
+#endif
+        return Isa::Scalar;
+    }();
+    return isa;
+}
+
+void FeedPeople([[maybe_unused]] const Isa isa,
+                const std::span<const People> population, const std::span<const Bushels> grain_to_feed,
+                const std::span<Bushels> grain_left, const std::span<People> dead) noexcept {
+    assert(population.size() == grain_to_feed.size());
+    assert(population.size() == grain_left.size() && population.size() == dead.size());
+#if HAMURABI_SIMD_X86
+    if constexpr (kHasVectorLayout) {
+        switch (isa) {
+            case Isa::Avx2: {
+                return FeedPeopleAvx2(population, grain_to_feed, grain_left, dead);
+            }
+            case Isa::Sse42: {
+                return FeedPeopleSse42(population, grain_to_feed, grain_left, dead);
+            }
+            case Isa::Scalar: {
+                break;
+            }
+        }
+    }
+#endif
+    FeedPeopleScalar(population, grain_to_feed, grain_left, dead, 0, population.size());
+}
+
+void FeedPeople(const std::span<const People> population, const std::span<const Bushels> grain_to_feed,
+                const std::span<Bushels> grain_left, const std::span<People> dead) noexcept {
+    FeedPeople(SupportedIsa(), population, grain_to_feed, grain_left, dead);
+}
+
+void IsGameOver([[maybe_unused]] const Isa isa,
+                const std::span<const People> dead_from_hunger, const std::span<const People> population,
+                const std::span<std::uint8_t> is_game_over) noexcept {
+    assert(dead_from_hunger.size() == population.size() && population.size() == is_game_over.size());
+#if HAMURABI_SIMD_X86
+    if constexpr (kHasVectorLayout) {
+        switch (isa) {
+            case Isa::Avx2: {
+                return IsGameOverAvx2(dead_from_hunger, population, is_game_over);
+            }
+            case Isa::Sse42: {
+                return IsGameOverSse42(dead_from_hunger, population, is_game_over);
+            }
+            case Isa::Scalar: {
+                break;
+            }
+        }
+    }
+#endif
+    IsGameOverScalar(dead_from_hunger, population, is_game_over, 0, population.size());
+}
+
+void IsGameOver(const std::span<const People> dead_from_hunger, const std::span<const People> population,
+                const std::span<std::uint8_t> is_game_over) noexcept {
+    IsGameOver(SupportedIsa(), dead_from_hunger, population, is_game_over);
+}
+
+void CountArrivedPeople([[maybe_unused]] const Isa isa,
+                        const std::span<const People> dead, const std::span<const Bushels> harvested_from_acre,
+                        const std::span<const Bushels> grain, const std::span<People> arrived) noexcept {
+    assert(dead.size() == harvested_from_acre.size());
+    assert(dead.size() == grain.size() && dead.size() == arrived.size());
+#if HAMURABI_SIMD_X86
+    if constexpr (kHasVectorLayout) {
+        switch (isa) {
+            case Isa::Avx2: {
+                return CountArrivedPeopleAvx2(dead, harvested_from_acre, grain, arrived);
+            }
+            case Isa::Sse42: {
+                return CountArrivedPeopleSse42(dead, harvested_from_acre, grain, arrived);
+            }
+            case Isa::Scalar: {
+                break;
+            }
+        }
+    }
+#endif
+    CountArrivedPeopleScalar(dead, harvested_from_acre, grain, arrived, 0, dead.size());
+}
+
+void CountArrivedPeople(const std::span<const People> dead, const std::span<const Bushels> harvested_from_acre,
+                        const std::span<const Bushels> grain, const std::span<People> arrived) noexcept {
+    CountArrivedPeople(SupportedIsa(), dead, harvested_from_acre, grain, arrived);
+}
+
+void GrainToPlantArea([[maybe_unused]] const Isa isa,
+                      const std::span<const Acres> area, const std::span<Bushels> grain) noexcept {
+    assert(area.size() == grain.size());
+#if HAMURABI_SIMD_X86
+    if constexpr (kHasVectorLayout) {
+        switch (isa) {
+            case Isa::Avx2: {
+                return GrainToPlantAreaAvx2(area, grain);
+            }
+            case Isa::Sse42: {
+                return GrainToPlantAreaSse42(area, grain);
+            }
+            case Isa::Scalar: {
+                break;
+            }
+        }
+    }
+#endif
+    GrainToPlantAreaScalar(area, grain, 0, area.size());
+}
+
+void GrainToPlantArea(const std::span<const Acres> area, const std::span<Bushels> grain) noexcept {
+    GrainToPlantArea(SupportedIsa(), area, grain);
+}
+
+}
+
+#endif //HAMURABI_DETAIL_SIMD_INL
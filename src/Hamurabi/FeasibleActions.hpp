@@ -0,0 +1,153 @@
+#ifndef HAMURABI_FEASIBLE_ACTIONS
+#define HAMURABI_FEASIBLE_ACTIONS
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <iterator>
+
+#include "RoundInput.hpp"
+#include "FeasibleRegion.hpp"
+
+namespace hamurabi {
+
+// every axis visits 0, step, 2 step and so on, and its bound last
+struct ActionGrid final {
+    Acres area_to_buy_step = 1;
+    Acres area_to_sell_step = 1;
+    Bushels grain_to_feed_step = 1;
+    Acres area_to_plant_step = 1;
+};
+
+// the round inputs a game state accepts, those RoundInput::New and AreaToPlant::New let through, as lattice points
+// counted in closed form, so they are sampled and walked without trying inputs which get rejected
+template<GameState G>
+class FeasibleActions final {
+  public:
+    class GridWalk;
+
+    // the game must outlive the actions
+    explicit FeasibleActions(const G &game);
+
+    [[nodiscard]]
+    constexpr const FeasibleRegion &Region() const noexcept;
+
+    [[nodiscard]]
+    std::uint64_t Size() const noexcept;
+
+    // ranks order by area to sell minus area to buy, then area to buy, grain to feed and area to plant
+    [[nodiscard]]
+    RoundInput At(std::uint64_t rank) const;
+
+    // every valid input equally likely
+    template<std::uniform_random_bit_generator U>
+    [[nodiscard]]
+    RoundInput Sample(U &random) const;
+
+    [[nodiscard]]
+    GridWalk Walk(ActionGrid grid) const;
+
+  private:
+    // the trade moves grain and area only by area to sell minus area to buy, so that difference, the net sale,
+    // is what the counts depend on
+    using NetSale = detail::AcresSigned;
+
+    struct TradeBounds final {
+        Bushels budget;
+        Bushels max_grain_to_feed;
+        Acres max_area_to_plant;
+    };
+
+    [[nodiscard]]
+    constexpr TradeBounds BoundsOf(NetSale net_sale) const noexcept;
+
+    // the inputs of a net sale with grain to feed at most the given, for every trade of it
+    [[nodiscard]]
+    constexpr std::uint64_t CountFeedAndPlant(const TradeBounds &bounds, Bushels grain_to_feed) const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToPlant(const TradeBounds &bounds, Bushels grain_to_feed) const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MinAreaToBuy(NetSale net_sale) const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToBuy(NetSale net_sale) const noexcept;
+
+    [[nodiscard]]
+    RoundInput MakeInput(Acres area_to_buy, Acres area_to_sell, Bushels grain_to_feed, Acres area_to_plant) const;
+
+    const G *game_;
+    FeasibleRegion region_;
+    Bushels acre_price_;
+    Acres area_can_plant_with_bushel_;
+    Acres max_area_to_buy_;
+    // inputs of all net sales up to each, from the largest purchase on
+    std::vector<std::uint64_t> cumulative_;
+};
+
+template<GameState G>
+class FeasibleActions<G>::GridWalk final {
+  public:
+    class Iterator final {
+      public:
+        using value_type = RoundInput;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        [[nodiscard]]
+        RoundInput operator*() const;
+
+        Iterator &operator++();
+
+        void operator++(int);
+
+        [[nodiscard]]
+        bool operator==(std::default_sentinel_t) const noexcept;
+
+      private:
+        friend class GridWalk;
+
+        Iterator(const FeasibleActions *actions, ActionGrid grid) noexcept;
+
+        void Enter() noexcept;
+
+        const FeasibleActions *actions_ = nullptr;
+        ActionGrid grid_{};
+        TradeBounds bounds_{};
+        Acres area_to_buy_ = 0;
+        Acres area_to_sell_ = 0;
+        Bushels grain_to_feed_ = 0;
+        Acres area_to_plant_ = 0;
+    };
+
+    [[nodiscard]]
+    Iterator begin() const noexcept;
+
+    [[nodiscard]]
+    std::default_sentinel_t end() const noexcept;
+
+  private:
+    friend class FeasibleActions;
+
+    GridWalk(const FeasibleActions &actions, ActionGrid grid) noexcept;
+
+    const FeasibleActions *actions_;
+    ActionGrid grid_;
+};
+
+namespace detail {
+
+// the next point of a grid axis, nothing after the bound
+[[nodiscard]]
+static inline constexpr std::optional<std::uint64_t> NextOnGrid(std::uint64_t value, std::uint64_t bound,
+                                                                std::uint64_t step) noexcept;
+
+}
+
+}
+
+#include "FeasibleActions.inl"
+
+#endif //HAMURABI_FEASIBLE_ACTIONS
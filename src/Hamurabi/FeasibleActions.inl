@@ -0,0 +1,241 @@
+#ifndef HAMURABI_FEASIBLE_ACTIONS_INL
+#define HAMURABI_FEASIBLE_ACTIONS_INL
+
+#include <cassert>
+#include <algorithm>
+
+namespace hamurabi {
+
+template<GameState G>
+FeasibleActions<G>::FeasibleActions(const G &game)
+    : game_{&game},
+      region_{game},
+      acre_price_{game.AcrePrice()},
+      area_can_plant_with_bushel_{detail::RulesOf(game).AreaCanPlantWithBushel()},
+      max_area_to_buy_{region_.MaxAreaToBuy()} {
+    const auto net_sales = static_cast<std::size_t>(max_area_to_buy_ + region_.MaxAreaToSell() + 1);
+    cumulative_.reserve(net_sales);
+    std::uint64_t inputs = 0;
+    for (std::size_t index = 0; index < net_sales; ++index) {
+        const auto net_sale = static_cast<NetSale>(index) - static_cast<NetSale>(max_area_to_buy_);
+        const auto bounds = BoundsOf(net_sale);
+        const auto trades = MaxAreaToBuy(net_sale) - MinAreaToBuy(net_sale) + 1;
+        inputs += trades * CountFeedAndPlant(bounds, bounds.max_grain_to_feed);
+        cumulative_.push_back(inputs);
+    }
+}
+
+template<GameState G>
+constexpr const FeasibleRegion &FeasibleActions<G>::Region() const noexcept {
+    return region_;
+}
+
+template<GameState G>
+std::uint64_t FeasibleActions<G>::Size() const noexcept {
+    return cumulative_.back();
+}
+
+template<GameState G>
+RoundInput FeasibleActions<G>::At(const std::uint64_t rank) const {
+    assert(rank < Size());
+    const auto found = std::upper_bound(cumulative_.begin(), cumulative_.end(), rank);
+    const auto index = static_cast<NetSale>(found - cumulative_.begin());
+    const auto net_sale = index - static_cast<NetSale>(max_area_to_buy_);
+    auto rest = rank - (found == cumulative_.begin() ? 0 : *std::prev(found));
+
+    const auto bounds = BoundsOf(net_sale);
+    const auto per_trade = CountFeedAndPlant(bounds, bounds.max_grain_to_feed);
+    const auto area_to_buy = MinAreaToBuy(net_sale) + static_cast<Acres>(rest / per_trade);
+    const auto area_to_sell = static_cast<Acres>(static_cast<NetSale>(area_to_buy) + net_sale);
+    rest %= per_trade;
+
+    // the first grain to feed whose inputs with less or equal feeding pass the rank
+    Bushels low = 0;
+    Bushels high = bounds.max_grain_to_feed;
+    while (low < high) {
+        const auto middle = low + ((high - low) / 2);
+        if (CountFeedAndPlant(bounds, middle) > rest) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    const auto grain_to_feed = low;
+    const auto before = grain_to_feed == 0 ? 0 : CountFeedAndPlant(bounds, grain_to_feed - 1);
+    const auto area_to_plant = static_cast<Acres>(rest - before);
+    return MakeInput(area_to_buy, area_to_sell, grain_to_feed, area_to_plant);
+}
+
+template<GameState G>
+template<std::uniform_random_bit_generator U>
+RoundInput FeasibleActions<G>::Sample(U &random) const {
+    std::uniform_int_distribution<std::uint64_t> rank{0, Size() - 1};
+    return At(rank(random));
+}
+
+template<GameState G>
+typename FeasibleActions<G>::GridWalk FeasibleActions<G>::Walk(const ActionGrid grid) const {
+    return GridWalk{*this, grid};
+}
+
+template<GameState G>
+constexpr typename FeasibleActions<G>::TradeBounds FeasibleActions<G>::BoundsOf(const NetSale net_sale) const noexcept {
+    const auto grain = region_.MaxGrainToFeed();
+    const auto area = region_.MaxAreaToSell();
+    // a purchase is bounded by the grain, so the budget is never negative
+    const auto budget = net_sale >= 0
+        ? grain + (static_cast<Bushels>(net_sale) * acre_price_)
+        : grain - (static_cast<Bushels>(-net_sale) * acre_price_);
+    const auto area_after_trade = net_sale >= 0
+        ? area - static_cast<Acres>(net_sale)
+        : area + static_cast<Acres>(-net_sale);
+    return TradeBounds{
+        .budget = budget,
+        .max_grain_to_feed = std::min(grain, budget),
+        .max_area_to_plant = std::min(region_.MaxAreaToPlant(), area_after_trade),
+    };
+}
+
+template<GameState G>
+constexpr std::uint64_t FeasibleActions<G>::CountFeedAndPlant(const TradeBounds &bounds,
+                                                              const Bushels grain_to_feed) const noexcept {
+    // a feeding which leaves `left` bushels allows min(max plant + 1, (left + 1) * k) areas to plant, the second
+    // one below left = max plant / k, so the sum over feedings is arithmetic there and constant above
+    const auto k = static_cast<std::uint64_t>(area_can_plant_with_bushel_);
+    const auto plants = static_cast<std::uint64_t>(bounds.max_area_to_plant) + 1;
+    const auto threshold = static_cast<std::uint64_t>(bounds.max_area_to_plant) / k;
+    const auto low = static_cast<std::uint64_t>(bounds.budget - grain_to_feed);
+    const auto high = static_cast<std::uint64_t>(bounds.budget);
+
+    std::uint64_t count = 0;
+    if (low < threshold) {
+        const auto last = std::min(high, threshold - 1);
+        const auto terms = last - low + 1;
+        count += k * ((terms * (low + 1)) + (terms * (terms - 1) / 2));
+    }
+    const auto first = std::max(low, threshold);
+    if (first <= high) {
+        count += plants * (high - first + 1);
+    }
+    return count;
+}
+
+template<GameState G>
+constexpr Acres FeasibleActions<G>::MaxAreaToPlant(const TradeBounds &bounds,
+                                                   const Bushels grain_to_feed) const noexcept {
+    const auto left = bounds.budget - grain_to_feed;
+    return std::min(bounds.max_area_to_plant,
+                    (left * area_can_plant_with_bushel_) + (area_can_plant_with_bushel_ - 1));
+}
+
+template<GameState G>
+constexpr Acres FeasibleActions<G>::MinAreaToBuy(const NetSale net_sale) const noexcept {
+    return net_sale < 0 ? static_cast<Acres>(-net_sale) : 0;
+}
+
+template<GameState G>
+constexpr Acres FeasibleActions<G>::MaxAreaToBuy(const NetSale net_sale) const noexcept {
+    const auto area = static_cast<NetSale>(region_.MaxAreaToSell());
+    return std::min(max_area_to_buy_, static_cast<Acres>(area - net_sale));
+}
+
+template<GameState G>
+RoundInput FeasibleActions<G>::MakeInput(const Acres area_to_buy, const Acres area_to_sell,
+                                         const Bushels grain_to_feed, const Acres area_to_plant) const {
+    return std::get<RoundInput>(RoundInput::New(
+        std::get<AreaToBuy>(AreaToBuy::New(area_to_buy, *game_, region_)),
+        std::get<AreaToSell>(AreaToSell::New(area_to_sell, *game_, region_)),
+        std::get<GrainToFeed>(GrainToFeed::New(grain_to_feed, *game_, region_)),
+        std::get<AreaToPlant>(AreaToPlant::New(area_to_plant, *game_, region_)),
+        *game_, region_));
+}
+
+template<GameState G>
+FeasibleActions<G>::GridWalk::GridWalk(const FeasibleActions &actions, const ActionGrid grid) noexcept
+    : actions_{&actions},
+      grid_{grid} {}
+
+template<GameState G>
+typename FeasibleActions<G>::GridWalk::Iterator FeasibleActions<G>::GridWalk::begin() const noexcept {
+    return Iterator{actions_, grid_};
+}
+
+template<GameState G>
+std::default_sentinel_t FeasibleActions<G>::GridWalk::end() const noexcept {
+    return std::default_sentinel;
+}
+
+template<GameState G>
+FeasibleActions<G>::GridWalk::Iterator::Iterator(const FeasibleActions *actions, const ActionGrid grid) noexcept
+    : actions_{actions},
+      grid_{grid} {
+    Enter();
+}
+
+template<GameState G>
+RoundInput FeasibleActions<G>::GridWalk::Iterator::operator*() const {
+    return actions_->MakeInput(area_to_buy_, area_to_sell_, grain_to_feed_, area_to_plant_);
+}
+
+// every trade has inputs, feeding and planting nothing at least, so the walk never enters an empty axis
+template<GameState G>
+typename FeasibleActions<G>::GridWalk::Iterator &FeasibleActions<G>::GridWalk::Iterator::operator++() {
+    const auto max_area_to_plant = actions_->MaxAreaToPlant(bounds_, grain_to_feed_);
+    if (const auto next = detail::NextOnGrid(area_to_plant_, max_area_to_plant, grid_.area_to_plant_step)) {
+        area_to_plant_ = static_cast<Acres>(*next);
+        return *this;
+    }
+    area_to_plant_ = 0;
+    if (const auto next = detail::NextOnGrid(grain_to_feed_, bounds_.max_grain_to_feed, grid_.grain_to_feed_step)) {
+        grain_to_feed_ = static_cast<Bushels>(*next);
+        return *this;
+    }
+    grain_to_feed_ = 0;
+    const auto max_area_to_sell = actions_->region_.MaxAreaToSell();
+    if (const auto next = detail::NextOnGrid(area_to_sell_, max_area_to_sell, grid_.area_to_sell_step)) {
+        area_to_sell_ = static_cast<Acres>(*next);
+        Enter();
+        return *this;
+    }
+    area_to_sell_ = 0;
+    if (const auto next = detail::NextOnGrid(area_to_buy_, actions_->max_area_to_buy_, grid_.area_to_buy_step)) {
+        area_to_buy_ = static_cast<Acres>(*next);
+        Enter();
+        return *this;
+    }
+    actions_ = nullptr;
+    return *this;
+}
+
+template<GameState G>
+void FeasibleActions<G>::GridWalk::Iterator::operator++(int) {
+    ++*this;
+}
+
+template<GameState G>
+bool FeasibleActions<G>::GridWalk::Iterator::operator==(std::default_sentinel_t) const noexcept {
+    return actions_ == nullptr;
+}
+
+template<GameState G>
+void FeasibleActions<G>::GridWalk::Iterator::Enter() noexcept {
+    if (actions_ != nullptr) {
+        bounds_ = actions_->BoundsOf(static_cast<NetSale>(area_to_sell_) - static_cast<NetSale>(area_to_buy_));
+    }
+}
+
+namespace detail {
+
+constexpr std::optional<std::uint64_t> NextOnGrid(const std::uint64_t value, const std::uint64_t bound,
+                                                  const std::uint64_t step) noexcept {
+    if (value >= bound) {
+        return std::nullopt;
+    }
+    return std::min(value + std::max<std::uint64_t>(step, 1), bound);
+}
+
+}
+
+}
+
+#endif //HAMURABI_FEASIBLE_ACTIONS_INL
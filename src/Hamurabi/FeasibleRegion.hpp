@@ -0,0 +1,71 @@
+#ifndef HAMURABI_FEASIBLE_REGION
+#define HAMURABI_FEASIBLE_REGION
+
+#include <optional>
+
+#include "Resources.hpp"
+#include "GameState.hpp"
+#include "Detail.hpp"
+
+namespace hamurabi {
+
+// the inputs a game state accepts, computed once so that every check after is a comparison or two
+class FeasibleRegion final {
+  public:
+    template<GameState G>
+    constexpr explicit FeasibleRegion(const G &game) noexcept;
+
+    // bounds of every component on its own, as AreaToBuy::New and the others check them
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToBuy() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToSell() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MaxGrainToFeed() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToPlant() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToPlantWithGrain() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres MaxAreaToPlantWithPopulation() const noexcept;
+
+    // bounds the round as a whole puts on the later components, the earlier ones within their own bounds
+
+    [[nodiscard]]
+    constexpr Bushels MaxGrainToFeed(Acres area_to_buy, Acres area_to_sell) const noexcept;
+
+    // nothing when the grain to feed leaves too little for the trade
+    [[nodiscard]]
+    constexpr std::optional<Acres> MaxAreaToPlant(Acres area_to_buy, Acres area_to_sell,
+                                                  Bushels grain_to_feed) const noexcept;
+
+    // the checks of RoundInput::New
+    [[nodiscard]]
+    constexpr bool HasAreaFor(Acres area_to_buy, Acres area_to_sell, Acres area_to_plant) const noexcept;
+
+    [[nodiscard]]
+    constexpr bool HasGrainFor(Acres area_to_buy, Acres area_to_sell, Bushels grain_to_feed,
+                               Acres area_to_plant) const noexcept;
+
+  private:
+    Acres area_;
+    Bushels grain_;
+    Bushels acre_price_;
+    Acres area_can_plant_with_bushel_;
+    Acres max_area_to_buy_;
+    Acres max_area_to_plant_with_grain_;
+    Acres max_area_to_plant_with_population_;
+    Acres max_area_to_plant_;
+};
+
+}
+
+#include "FeasibleRegion.inl"
+
+#endif //HAMURABI_FEASIBLE_REGION
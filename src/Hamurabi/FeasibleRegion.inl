@@ -0,0 +1,75 @@
+#ifndef HAMURABI_FEASIBLE_REGION_INL
+#define HAMURABI_FEASIBLE_REGION_INL
+
+#include <algorithm>
+
+namespace hamurabi {
+
+template<GameState G>
+constexpr FeasibleRegion::FeasibleRegion(const G &game) noexcept
+    : area_{game.Area()},
+      grain_{game.Grain()},
+      acre_price_{game.AcrePrice()},
+      area_can_plant_with_bushel_{detail::RulesOf(game).AreaCanPlantWithBushel()},
+      max_area_to_buy_{grain_ / acre_price_},
+      max_area_to_plant_with_grain_{detail::AreaCanPlantWithGrain(grain_, detail::RulesOf(game))},
+      max_area_to_plant_with_population_{
+          detail::AreaCanPlantWithPopulation(game.Population(), detail::RulesOf(game))},
+      max_area_to_plant_{std::min({area_, max_area_to_plant_with_grain_, max_area_to_plant_with_population_})} {}
+
+constexpr Acres FeasibleRegion::MaxAreaToBuy() const noexcept {
+    return max_area_to_buy_;
+}
+
+constexpr Acres FeasibleRegion::MaxAreaToSell() const noexcept {
+    return area_;
+}
+
+constexpr Bushels FeasibleRegion::MaxGrainToFeed() const noexcept {
+    return grain_;
+}
+
+constexpr Acres FeasibleRegion::MaxAreaToPlant() const noexcept {
+    return max_area_to_plant_;
+}
+
+constexpr Acres FeasibleRegion::MaxAreaToPlantWithGrain() const noexcept {
+    return max_area_to_plant_with_grain_;
+}
+
+constexpr Acres FeasibleRegion::MaxAreaToPlantWithPopulation() const noexcept {
+    return max_area_to_plant_with_population_;
+}
+
+constexpr Bushels FeasibleRegion::MaxGrainToFeed(const Acres area_to_buy, const Acres area_to_sell) const noexcept {
+    // buying stays within the grain, so the budget is never negative
+    const auto budget = grain_ + (area_to_sell * acre_price_) - (area_to_buy * acre_price_);
+    return std::min(grain_, budget);
+}
+
+constexpr std::optional<Acres> FeasibleRegion::MaxAreaToPlant(const Acres area_to_buy, const Acres area_to_sell,
+                                                              const Bushels grain_to_feed) const noexcept {
+    const auto budget = grain_ + (area_to_sell * acre_price_) - (area_to_buy * acre_price_);
+    if (grain_to_feed > budget) {
+        return std::nullopt;
+    }
+    // a bushel plants a whole group of acres, an incomplete group at the end costs nothing
+    const auto left = budget - grain_to_feed;
+    const auto area_with_left = (left * area_can_plant_with_bushel_) + (area_can_plant_with_bushel_ - 1);
+    return std::min({max_area_to_plant_, area_ + area_to_buy - area_to_sell, area_with_left});
+}
+
+constexpr bool FeasibleRegion::HasAreaFor(const Acres area_to_buy, const Acres area_to_sell,
+                                          const Acres area_to_plant) const noexcept {
+    return area_to_sell + area_to_plant <= area_ + area_to_buy;
+}
+
+constexpr bool FeasibleRegion::HasGrainFor(const Acres area_to_buy, const Acres area_to_sell,
+                                           const Bushels grain_to_feed, const Acres area_to_plant) const noexcept {
+    const auto grain_to_plant = area_to_plant / area_can_plant_with_bushel_;
+    return (area_to_buy * acre_price_) + grain_to_feed + grain_to_plant <= grain_ + (area_to_sell * acre_price_);
+}
+
+}
+
+#endif //HAMURABI_FEASIBLE_REGION_INL
@@ -1,6 +1,7 @@
 #ifndef HAMURABI_GAME
 #define HAMURABI_GAME
 
+#include <utility>
 #include <optional>
 
 #include "NotEnoughArea.hpp"
@@ -16,6 +17,9 @@
 #include "GameEnd.hpp"
 #include "Statistics.hpp"
 #include "Detail.hpp"
+#include "Instrumentation.hpp"
+#include "Rules.hpp"
+#include "Game.fwd"
 
 namespace hamurabi {
 
@@ -23,7 +27,7 @@ using RoundResult = std::variant<Continue, GameOver, GameEnd>;
 
 namespace ser = serialization;
 
-template<class T>
+template<class T, class I, class R>
 class Game final {
   public:
     Game(Game &&other) = default;
@@ -32,7 +36,7 @@ class Game final {
     Game(const Game &) = delete;
     Game &operator=(const Game &) = delete;
 
-    explicit Game(T generator);
+    explicit Game(T generator, R rules = R{});
 
     [[nodiscard]]
     constexpr Round CurrentRound() const noexcept;
@@ -73,11 +77,37 @@ class Game final {
     [[nodiscard("result should be presented to the user")]]
     std::optional<Statistics> Statistics() const noexcept;
 
-    friend void ser::InsertGame<T>(std::ostream &ostream, const Game<T> &game, ser::Format format);
+    [[nodiscard]]
+    constexpr const I &Instrumentation() const noexcept;
+
+    [[nodiscard]]
+    constexpr const R &Rules() const noexcept;
+
+    // the state and the generator under other policies, rounds after the fork play by the new rules
+    template<class J, class Q>
+    [[nodiscard]]
+    Game<T, J, Q> Fork(Q rules) const;
+
+    friend void ser::InsertGame<T, I, R>(std::ostream &ostream, const Game<T, I, R> &game, ser::Format format);
+
+    friend ser::ExtractResult ser::ExtractGame<T, I, R>(std::istream &istream, Game<T, I, R> &game, ser::Format format);
 
-    friend ser::ExtractResult ser::ExtractGame<T>(std::istream &istream, Game<T> &game, ser::Format format);
+    friend ser::ExtractReport ser::ExtractGame<T, I, R>(std::string_view string, Game<T, I, R> &game) noexcept;
+
+    friend void ser::InsertGenerator<T, I, R>(std::ostream &ostream, const Game<T, I, R> &game);
+
+    friend ser::ExtractResult ser::ExtractGenerator<T, I, R>(std::istream &istream, Game<T, I, R> &game);
+
+    friend void ser::InsertGame<T, I, R>(std::span<std::byte, ser::kBinaryGameSize> bytes,
+                                      const Game<T, I, R> &game) noexcept;
+
+    friend ser::ExtractResult ser::ExtractGame<T, I, R>(std::span<const std::byte, ser::kBinaryGameSize> bytes,
+                                                     Game<T, I, R> &game) noexcept;
 
   private:
+    template<class, class, class>
+    friend class Game;
+
     People population_;
     Acres area_;
     Bushels grain_;
@@ -90,11 +120,18 @@ class Game final {
     Round current_round_;
     bool is_plague_;
     bool is_game_over_;
+    detail::Distributions distributions_;
     T generator_;
+    [[no_unique_address]] I instrumentation_;
+    [[no_unique_address]] R rules_;
 };
 
 }
 
 #include "Game.inl"
 
+#ifdef HAMURABI_CORE
+#include "Instantiations.hpp"
+#endif
+
 #endif //HAMURABI_GAME
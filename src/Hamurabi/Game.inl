@@ -3,139 +3,217 @@
 
 namespace hamurabi {
 
-template<class T>
-Game<T>::Game(T generator)
+template<class T, class I, class R>
+Game<T, I, R>::Game(T generator, R rules)
     : generator_{generator},
       current_round_{detail::kFirstRound},
-      population_{detail::kStartPopulation},
-      area_{detail::kStartArea},
-      grain_{detail::kStartGrain},
+      population_{rules.StartPopulation()},
+      area_{rules.StartArea()},
+      grain_{rules.StartGrain()},
       dead_from_hunger_{detail::kStartDeadFromHunger},
       dead_from_hunger_in_total_{detail::kStartDeadFromHunger},
-      arrived_{detail::kStartArrived},
-      grain_from_acre_{detail::kStartGrainFromAcre},
-      grain_eaten_by_rats_{detail::kStartGrainEatenByRats},
+      arrived_{rules.StartArrived()},
+      grain_from_acre_{rules.StartGrainFromAcre()},
+      grain_eaten_by_rats_{rules.StartGrainEatenByRats()},
       is_plague_{detail::kStartIsPlague},
-      is_game_over_{detail::kStartIsGameOver} {
-    acre_price_ = detail::GenerateAcrePrice(generator_);
+      is_game_over_{detail::kStartIsGameOver},
+      distributions_{detail::MakeDistributions(rules)},
+      rules_{rules} {
+    detail::SeekGenerator(generator_, current_round_, RandomEvent::AcrePrice);
+    decltype(auto) random = instrumentation_.Draws(generator_);
+    acre_price_ = detail::GenerateAcrePrice(random, distributions_);
 }
 
-template<class T>
-constexpr Round Game<T>::CurrentRound() const noexcept {
+template<class T, class I, class R>
+constexpr Round Game<T, I, R>::CurrentRound() const noexcept {
     return current_round_;
 }
 
-template<class T>
-constexpr People Game<T>::Population() const noexcept {
+template<class T, class I, class R>
+constexpr People Game<T, I, R>::Population() const noexcept {
     return population_;
 }
 
-template<class T>
-constexpr Acres Game<T>::Area() const noexcept {
+template<class T, class I, class R>
+constexpr Acres Game<T, I, R>::Area() const noexcept {
     return area_;
 }
 
-template<class T>
-constexpr Bushels Game<T>::Grain() const noexcept {
+template<class T, class I, class R>
+constexpr Bushels Game<T, I, R>::Grain() const noexcept {
     return grain_;
 }
 
-template<class T>
-constexpr Bushels Game<T>::AcrePrice() const noexcept {
+template<class T, class I, class R>
+constexpr Bushels Game<T, I, R>::AcrePrice() const noexcept {
     return acre_price_;
 }
 
-template<class T>
-constexpr People Game<T>::DeadFromHunger() const noexcept {
+template<class T, class I, class R>
+constexpr People Game<T, I, R>::DeadFromHunger() const noexcept {
     return dead_from_hunger_;
 }
 
-template<class T>
-constexpr People Game<T>::DeadFromHungerInTotal() const noexcept {
+template<class T, class I, class R>
+constexpr People Game<T, I, R>::DeadFromHungerInTotal() const noexcept {
     return dead_from_hunger_in_total_;
 }
 
-template<class T>
-constexpr People Game<T>::Arrived() const noexcept {
+template<class T, class I, class R>
+constexpr People Game<T, I, R>::Arrived() const noexcept {
     return arrived_;
 }
 
-template<class T>
-constexpr Bushels Game<T>::GrainFromAcre() const noexcept {
+template<class T, class I, class R>
+constexpr Bushels Game<T, I, R>::GrainFromAcre() const noexcept {
     return grain_from_acre_;
 }
 
-template<class T>
-constexpr Bushels Game<T>::GrainEatenByRats() const noexcept {
+template<class T, class I, class R>
+constexpr Bushels Game<T, I, R>::GrainEatenByRats() const noexcept {
     return grain_eaten_by_rats_;
 }
 
-template<class T>
-constexpr bool Game<T>::IsPlague() const noexcept {
+template<class T, class I, class R>
+constexpr bool Game<T, I, R>::IsPlague() const noexcept {
     return is_plague_;
 }
 
-template<class T>
-RoundResult Game<T>::PlayRound(const RoundInput input) {
+template<class T, class I, class R>
+RoundResult Game<T, I, R>::PlayRound(const RoundInput input) {
     if (is_game_over_) {
+        instrumentation_.CountGameOver();
         return GameOver{*this};
     }
-    if (current_round_ > detail::kLastRound) {
+    if (current_round_ > rules_.LastRound()) {
+        instrumentation_.CountGameEnd();
         return GameEnd{};
     }
+    instrumentation_.CountRound();
     current_round_ += 1;
 
-    const auto area_to_buy = static_cast<Acres>(input.AreaToBuy());
-    area_ += area_to_buy;
-    const Bushels grain_to_buy_area = area_to_buy * acre_price_;
-    grain_ -= grain_to_buy_area;
-
-    const auto area_to_sell = static_cast<Acres>(input.AreaToSell());
-    area_ -= area_to_sell;
-    const Bushels grain_to_sell_area = area_to_sell * acre_price_;
-    grain_ += grain_to_sell_area;
-
-    const auto area_to_plant = static_cast<Acres>(input.AreaToPlant());
-    grain_from_acre_ = detail::GenerateGrainHarvestedFromAcre(generator_);
-    const Bushels grain_harvested = area_to_plant * grain_from_acre_;
-    grain_ += grain_harvested;
-    const Bushels grain_to_plant_area = detail::GrainToPlantArea(area_to_plant);
-    grain_ -= grain_to_plant_area;
-
-    const auto grain_to_feed = static_cast<Bushels>(input.GrainToFeed());
-    const auto feed_people_result = detail::FeedPeople(population_, grain_to_feed);
-    grain_ += feed_people_result.grain_left;
-    grain_ -= grain_to_feed;
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Trade);
+        const auto area_to_buy = static_cast<Acres>(input.AreaToBuy());
+        area_ += area_to_buy;
+        const Bushels grain_to_buy_area = area_to_buy * acre_price_;
+        grain_ -= grain_to_buy_area;
+
+        const auto area_to_sell = static_cast<Acres>(input.AreaToSell());
+        area_ -= area_to_sell;
+        const Bushels grain_to_sell_area = area_to_sell * acre_price_;
+        grain_ += grain_to_sell_area;
+    }
+
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Harvest);
+        const auto area_to_plant = static_cast<Acres>(input.AreaToPlant());
+        detail::SeekGenerator(generator_, current_round_, RandomEvent::GrainHarvestedFromAcre);
+        decltype(auto) random = instrumentation_.Draws(generator_);
+        grain_from_acre_ = detail::GenerateGrainHarvestedFromAcre(random, distributions_);
+        const Bushels grain_harvested = area_to_plant * grain_from_acre_;
+        grain_ += grain_harvested;
+        const Bushels grain_to_plant_area = detail::GrainToPlantArea(area_to_plant, rules_);
+        grain_ -= grain_to_plant_area;
+    }
+
     const auto old_population = population_;
-    dead_from_hunger_ = feed_people_result.dead;
-    population_ -= dead_from_hunger_;
-    dead_from_hunger_in_total_ += dead_from_hunger_;
-    if (detail::IsGameOver(dead_from_hunger_, old_population)) {
-        is_game_over_ = true;
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Feeding);
+        const auto grain_to_feed = static_cast<Bushels>(input.GrainToFeed());
+        const auto feed_people_result = detail::FeedPeople(population_, grain_to_feed, rules_);
+        grain_ += feed_people_result.grain_left;
+        grain_ -= grain_to_feed;
+        dead_from_hunger_ = feed_people_result.dead;
+        population_ -= dead_from_hunger_;
+        dead_from_hunger_in_total_ += dead_from_hunger_;
+    }
+
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::GameOverCheck);
+        is_game_over_ = detail::IsGameOver(dead_from_hunger_, old_population, rules_);
+    }
+    if (is_game_over_) {
+        instrumentation_.CountGameOver();
         return GameOver{*this};
     }
 
-    grain_eaten_by_rats_ = detail::GenerateGrainEatenByRats(generator_, grain_);
-    grain_ -= grain_eaten_by_rats_;
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Rats);
+        detail::SeekGenerator(generator_, current_round_, RandomEvent::GrainEatenByRats);
+        decltype(auto) random = instrumentation_.Draws(generator_);
+        grain_eaten_by_rats_ = detail::GenerateGrainEatenByRats(random, distributions_, grain_, rules_);
+        grain_ -= grain_eaten_by_rats_;
+    }
 
-    arrived_ = detail::CountArrivedPeople(dead_from_hunger_, grain_from_acre_, grain_);
-    population_ += arrived_;
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Arrivals);
+        arrived_ = detail::CountArrivedPeople(dead_from_hunger_, grain_from_acre_, grain_, rules_);
+        population_ += arrived_;
+    }
 
-    is_plague_ = detail::GenerateIsPlague(generator_);
-    if (is_plague_) {
-        population_ /= 2;
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Plague);
+        detail::SeekGenerator(generator_, current_round_, RandomEvent::IsPlague);
+        decltype(auto) random = instrumentation_.Draws(generator_);
+        is_plague_ = detail::GenerateIsPlague(random, distributions_, rules_);
+        if (is_plague_) {
+            population_ /= 2;
+        }
     }
 
-    acre_price_ = detail::GenerateAcrePrice(generator_);
-    if (current_round_ > detail::kLastRound) {
+    {
+        [[maybe_unused]] const auto scope = instrumentation_.Measure(Phase::Price);
+        detail::SeekGenerator(generator_, current_round_, RandomEvent::AcrePrice);
+        decltype(auto) random = instrumentation_.Draws(generator_);
+        acre_price_ = detail::GenerateAcrePrice(random, distributions_);
+    }
+    if (current_round_ > rules_.LastRound()) {
+        // a plague can halve the last person away, an empty city is not ranked
+        if (population_ == 0) {
+            is_game_over_ = true;
+            instrumentation_.CountGameOver();
+            return GameOver{*this};
+        }
+        instrumentation_.CountGameEnd();
         return GameEnd{};
     }
     return Continue{};
 }
 
-template<class T>
-std::optional<Statistics> Game<T>::Statistics() const noexcept {
-    if (current_round_ > detail::kLastRound) {
+template<class T, class I, class R>
+constexpr const I &Game<T, I, R>::Instrumentation() const noexcept {
+    return instrumentation_;
+}
+
+template<class T, class I, class R>
+constexpr const R &Game<T, I, R>::Rules() const noexcept {
+    return rules_;
+}
+
+template<class T, class I, class R>
+template<class J, class Q>
+Game<T, J, Q> Game<T, I, R>::Fork(Q rules) const {
+    Game<T, J, Q> game{generator_, std::move(rules)};
+    game.population_ = population_;
+    game.area_ = area_;
+    game.grain_ = grain_;
+    game.acre_price_ = acre_price_;
+    game.dead_from_hunger_ = dead_from_hunger_;
+    game.dead_from_hunger_in_total_ = dead_from_hunger_in_total_;
+    game.arrived_ = arrived_;
+    game.grain_from_acre_ = grain_from_acre_;
+    game.grain_eaten_by_rats_ = grain_eaten_by_rats_;
+    game.current_round_ = current_round_;
+    game.is_plague_ = is_plague_;
+    game.is_game_over_ = is_game_over_;
+    game.generator_ = generator_;
+    return game;
+}
+
+template<class T, class I, class R>
+std::optional<Statistics> Game<T, I, R>::Statistics() const noexcept {
+    if (current_round_ > rules_.LastRound() && !is_game_over_) {
         return hamurabi::Statistics{*this};
     }
     return std::nullopt;
@@ -143,8 +221,15 @@ std::optional<Statistics> Game<T>::Statistics() const noexcept {
 
 namespace serialization {
 
-template<class T>
-void InsertGame(std::ostream &ostream, const Game<T> &game, [[maybe_unused]] const Format format) {
+template<class T, class I, class R>
+void InsertGame(std::ostream &ostream, const Game<T, I, R> &game, const Format format) {
+    if (format == Format::Binary) {
+        std::array<std::byte, kBinaryGameSize> bytes{};
+        InsertGame(std::span{bytes}, game);
+        ostream.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return;
+    }
+
     const auto insert_tag = [&ostream](const auto tag) -> auto & {
         ostream << detail::kInsertTagIndent << tag << detail::kInsertTagDelim << " ";
         return ostream;
@@ -164,8 +249,17 @@ void InsertGame(std::ostream &ostream, const Game<T> &game, [[maybe_unused]] con
     insert_tag(detail::kInsertIsPlagueTag) << std::boolalpha << game.IsPlague() << "\n";
 }
 
-template<class T>
-ExtractResult ExtractGame(std::istream &istream, Game<T> &game, const Format format) {
+template<class T, class I, class R>
+ExtractResult ExtractGame(std::istream &istream, Game<T, I, R> &game, const Format format) {
+    if (format == Format::Binary) {
+        std::array<std::byte, kBinaryGameSize> bytes{};
+        istream.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (istream.gcount() != static_cast<std::streamsize>(bytes.size())) {
+            return ExtractResult::Error;
+        }
+        return ExtractGame(std::span<const std::byte, kBinaryGameSize>{bytes}, game);
+    }
+
     std::string buffer;
 
     switch (detail::ExtractCurrentRound(istream, buffer, game.current_round_, format)) {
@@ -251,6 +345,125 @@ ExtractResult ExtractGame(std::istream &istream, Game<T> &game, const Format for
     return detail::ExtractIsPlague(istream, buffer, game.is_plague_, format);
 }
 
+template<class T, class I, class R>
+void InsertGenerator(std::ostream &ostream, const Game<T, I, R> &game) {
+    const auto &distributions = game.distributions_;
+    ostream << game.generator_ << ' '
+            << distributions.acre_price << ' '
+            << distributions.grain_harvested_from_acre << ' '
+            << distributions.grain_eaten_by_rats << ' '
+            << distributions.plague_percent;
+}
+
+template<class T, class I, class R>
+ExtractResult ExtractGenerator(std::istream &istream, Game<T, I, R> &game) {
+    auto &distributions = game.distributions_;
+    istream >> game.generator_
+            >> distributions.acre_price
+            >> distributions.grain_harvested_from_acre
+            >> distributions.grain_eaten_by_rats
+            >> distributions.plague_percent;
+    return istream ? ExtractResult::Success : ExtractResult::Error;
+}
+
+template<class T, class I, class R>
+ExtractReport ExtractGame(const std::string_view string, Game<T, I, R> &game) noexcept {
+    std::size_t offset = 0;
+    const auto extract_number = [string, &offset](const auto tag, auto &value) {
+        return detail::ExtractTag(string, offset, tag) && detail::ExtractNumber(string, offset, value);
+    };
+
+    const auto success = detail::ExtractTag(string, offset, detail::kInsertGameTag) &&
+        extract_number(detail::kInsertCurrentRoundTag, game.current_round_) &&
+        extract_number(detail::kInsertPopulationTag, game.population_) &&
+        extract_number(detail::kInsertAreaTag, game.area_) &&
+        extract_number(detail::kInsertGrainTag, game.grain_) &&
+        extract_number(detail::kInsertAcrePriceTag, game.acre_price_) &&
+        extract_number(detail::kInsertDeadFromHungerTag, game.dead_from_hunger_) &&
+        extract_number(detail::kInsertDeadFromHungerInTotalTag, game.dead_from_hunger_in_total_) &&
+        extract_number(detail::kInsertArrivedTag, game.arrived_) &&
+        extract_number(detail::kInsertGrainFromAcreTag, game.grain_from_acre_) &&
+        extract_number(detail::kInsertGrainEatenByRatsTag, game.grain_eaten_by_rats_) &&
+        detail::ExtractTag(string, offset, detail::kInsertIsPlagueTag) &&
+        detail::ExtractBool(string, offset, game.is_plague_);
+    return {
+        .result = success ? ExtractResult::Success : ExtractResult::Error,
+        .offset = offset,
+    };
+}
+
+template<class T, class I, class R>
+void InsertGame(const std::span<std::byte, kBinaryGameSize> bytes, const Game<T, I, R> &game) noexcept {
+    std::copy(detail::kBinaryMagic.begin(), detail::kBinaryMagic.end(), bytes.begin());
+    detail::StoreLittleEndian(bytes.subspan(4, 2), detail::kBinaryVersion);
+    detail::StoreLittleEndian(bytes.subspan(6, 2), kBinaryGameSize);
+
+    const std::array<std::uint64_t, 10> fields = {
+        game.current_round_,
+        game.population_,
+        game.area_,
+        game.grain_,
+        game.acre_price_,
+        game.dead_from_hunger_,
+        game.dead_from_hunger_in_total_,
+        game.arrived_,
+        game.grain_from_acre_,
+        game.grain_eaten_by_rats_,
+    };
+    auto field_bytes = bytes.subspan(detail::kBinaryFieldsOffset);
+    for (const auto field : fields) {
+        detail::StoreLittleEndian(field_bytes.first(8), field);
+        field_bytes = field_bytes.subspan(8);
+    }
+
+    std::uint8_t flags = 0;
+    if (game.is_plague_) {
+        flags |= detail::kBinaryIsPlagueFlag;
+    }
+    if (game.is_game_over_) {
+        flags |= detail::kBinaryIsGameOverFlag;
+    }
+    detail::StoreLittleEndian(bytes.subspan(detail::kBinaryFlagsOffset, 8), flags);
+
+    const auto checksum = detail::Fnv1a(bytes.first(detail::kBinaryChecksumOffset));
+    detail::StoreLittleEndian(bytes.subspan(detail::kBinaryChecksumOffset, 8), checksum);
+}
+
+template<class T, class I, class R>
+ExtractResult ExtractGame(const std::span<const std::byte, kBinaryGameSize> bytes, Game<T, I, R> &game) noexcept {
+    const auto has_magic = std::equal(detail::kBinaryMagic.begin(), detail::kBinaryMagic.end(), bytes.begin());
+    const auto version = detail::LoadLittleEndian(bytes.subspan(4, 2));
+    const auto size = detail::LoadLittleEndian(bytes.subspan(6, 2));
+    if (!has_magic || version != detail::kBinaryVersion || size != kBinaryGameSize) {
+        return ExtractResult::Error;
+    }
+    const auto checksum = detail::LoadLittleEndian(bytes.subspan(detail::kBinaryChecksumOffset, 8));
+    if (checksum != detail::Fnv1a(bytes.first(detail::kBinaryChecksumOffset))) {
+        return ExtractResult::Error;
+    }
+    const auto flags = detail::LoadLittleEndian(bytes.subspan(detail::kBinaryFlagsOffset, 8));
+    if ((flags & ~std::uint64_t{detail::kBinaryIsPlagueFlag | detail::kBinaryIsGameOverFlag}) != 0) {
+        return ExtractResult::Error;
+    }
+
+    const auto field = [bytes](const std::size_t index) {
+        return detail::LoadLittleEndian(bytes.subspan(detail::kBinaryFieldsOffset + index * 8, 8));
+    };
+    game.current_round_ = static_cast<Round>(field(0));
+    game.population_ = static_cast<People>(field(1));
+    game.area_ = static_cast<Acres>(field(2));
+    game.grain_ = static_cast<Bushels>(field(3));
+    game.acre_price_ = static_cast<Bushels>(field(4));
+    game.dead_from_hunger_ = static_cast<People>(field(5));
+    game.dead_from_hunger_in_total_ = static_cast<People>(field(6));
+    game.arrived_ = static_cast<People>(field(7));
+    game.grain_from_acre_ = static_cast<Bushels>(field(8));
+    game.grain_eaten_by_rats_ = static_cast<Bushels>(field(9));
+    game.is_plague_ = (flags & detail::kBinaryIsPlagueFlag) != 0;
+    game.is_game_over_ = (flags & detail::kBinaryIsGameOverFlag) != 0;
+    return ExtractResult::Success;
+}
+
 }
 
 }
@@ -0,0 +1,90 @@
+#ifndef HAMURABI_GAME_ARCHIVE
+#define HAMURABI_GAME_ARCHIVE
+
+#include <vector>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+
+#include "Game.hpp"
+
+namespace hamurabi::serialization {
+
+using GameKey = std::uint64_t;
+
+// header, then fixed-size binary records in append order, then the index of (key, record) sorted by key
+class GameArchiveWriter final {
+  public:
+    GameArchiveWriter(GameArchiveWriter &&other) noexcept = default;
+    GameArchiveWriter &operator=(GameArchiveWriter &&other) noexcept = default;
+
+    GameArchiveWriter(const GameArchiveWriter &) = delete;
+    GameArchiveWriter &operator=(const GameArchiveWriter &) = delete;
+
+    ~GameArchiveWriter();
+
+    [[nodiscard]]
+    static std::optional<GameArchiveWriter> Open(const std::filesystem::path &path);
+
+    [[nodiscard]]
+    std::uint64_t Size() const noexcept;
+
+    template<class T>
+    void Append(GameKey key, const Game<T> &game);
+
+    [[nodiscard]]
+    InsertResult Close();
+
+  private:
+    struct IndexEntry final {
+        GameKey key;
+        std::uint64_t record;
+    };
+
+    GameArchiveWriter(std::fstream file, std::vector<IndexEntry> index);
+
+    std::fstream file_;
+    std::vector<IndexEntry> index_;
+};
+
+class GameArchiveReader final {
+  public:
+    GameArchiveReader(GameArchiveReader &&other) noexcept;
+    GameArchiveReader &operator=(GameArchiveReader &&other) noexcept;
+
+    GameArchiveReader(const GameArchiveReader &) = delete;
+    GameArchiveReader &operator=(const GameArchiveReader &) = delete;
+
+    ~GameArchiveReader();
+
+    [[nodiscard]]
+    static std::optional<GameArchiveReader> Open(const std::filesystem::path &path);
+
+    [[nodiscard]]
+    std::uint64_t Size() const noexcept;
+
+    [[nodiscard]]
+    GameKey Key(std::uint64_t record) const noexcept;
+
+    [[nodiscard]]
+    std::span<const std::byte, kBinaryGameSize> Record(std::uint64_t record) const noexcept;
+
+    [[nodiscard]]
+    std::optional<std::uint64_t> Find(GameKey key) const noexcept;
+
+    template<class T>
+    [[nodiscard]]
+    ExtractResult ExtractGame(GameKey key, Game<T> &game) const noexcept;
+
+  private:
+    explicit GameArchiveReader(std::span<const std::byte> bytes) noexcept;
+
+    std::span<const std::byte> bytes_;
+    std::uint64_t size_;
+};
+
+}
+
+#include "GameArchive.inl"
+
+#endif //HAMURABI_GAME_ARCHIVE
@@ -0,0 +1,308 @@
+#ifndef HAMURABI_GAME_ARCHIVE_INL
+#define HAMURABI_GAME_ARCHIVE_INL
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace hamurabi {
+
+namespace detail {
+
+inline constexpr std::array<std::byte, 4> kArchiveMagic = {std::byte{'H'}, std::byte{'M'}, std::byte{'R'}, std::byte{'A'}};
+inline constexpr std::uint16_t kArchiveVersion = 1;
+
+// magic, version, record size, record count, index offset, reserved
+inline constexpr std::size_t kArchiveHeaderSize = 32;
+inline constexpr std::size_t kArchiveRecordSize = 8 + ser::kBinaryGameSize;
+inline constexpr std::size_t kArchiveIndexEntrySize = 16;
+
+// index offset of an archive which is being appended to, or which writer did not close
+inline constexpr std::uint64_t kArchiveNotClosed = 0;
+
+struct ArchiveHeader final {
+    std::uint64_t record_count;
+    std::uint64_t index_offset;
+};
+
+constexpr void InsertArchiveHeader(const std::span<std::byte, kArchiveHeaderSize> bytes,
+                                   const ArchiveHeader header) noexcept {
+    std::copy(kArchiveMagic.begin(), kArchiveMagic.end(), bytes.begin());
+    StoreLittleEndian(bytes.subspan(4, 2), kArchiveVersion);
+    StoreLittleEndian(bytes.subspan(6, 2), kArchiveRecordSize);
+    StoreLittleEndian(bytes.subspan(8, 8), header.record_count);
+    StoreLittleEndian(bytes.subspan(16, 8), header.index_offset);
+    StoreLittleEndian(bytes.subspan(24, 8), 0);
+}
+
+[[nodiscard]]
+constexpr std::optional<ArchiveHeader> ExtractArchiveHeader(const std::span<const std::byte> bytes) noexcept {
+    if (bytes.size() < kArchiveHeaderSize) {
+        return std::nullopt;
+    }
+    const auto has_magic = std::equal(kArchiveMagic.begin(), kArchiveMagic.end(), bytes.begin());
+    const auto version = LoadLittleEndian(bytes.subspan(4, 2));
+    const auto record_size = LoadLittleEndian(bytes.subspan(6, 2));
+    if (!has_magic || version != kArchiveVersion || record_size != kArchiveRecordSize) {
+        return std::nullopt;
+    }
+    return ArchiveHeader{
+        .record_count = LoadLittleEndian(bytes.subspan(8, 8)),
+        .index_offset = LoadLittleEndian(bytes.subspan(16, 8)),
+    };
+}
+
+constexpr std::uint64_t ArchiveRecordOffset(const std::uint64_t record) noexcept {
+    return kArchiveHeaderSize + record * kArchiveRecordSize;
+}
+
+}
+
+namespace serialization {
+
+inline GameArchiveWriter::GameArchiveWriter(std::fstream file, std::vector<IndexEntry> index)
+    : file_{std::move(file)},
+      index_{std::move(index)} {}
+
+inline GameArchiveWriter::~GameArchiveWriter() {
+    if (file_.is_open()) {
+        (void) Close();
+    }
+}
+
+inline std::optional<GameArchiveWriter> GameArchiveWriter::Open(const std::filesystem::path &path) {
+    constexpr auto mode = std::fstream::in | std::fstream::out | std::fstream::binary;
+    std::error_code error;
+    const auto file_size = std::filesystem::exists(path, error) ? std::filesystem::file_size(path, error) : 0;
+    if (error) {
+        return std::nullopt;
+    }
+    std::fstream file{path, file_size == 0 ? mode | std::fstream::trunc : mode};
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::vector<IndexEntry> index;
+    if (file_size != 0) {
+        std::array<std::byte, detail::kArchiveHeaderSize> header_bytes{};
+        file.read(reinterpret_cast<char *>(header_bytes.data()), header_bytes.size());
+        const auto header = detail::ExtractArchiveHeader(std::span{header_bytes}.first(file.gcount()));
+        if (!header.has_value()) {
+            return std::nullopt;
+        }
+
+        // a closed archive keeps its keys in the index, otherwise they are recovered from the records
+        if (header->index_offset != detail::kArchiveNotClosed) {
+            // the counts come from the file, so they are checked against its size before anything is allocated
+            const auto max_record_count = (file_size - detail::kArchiveHeaderSize) / detail::kArchiveRecordSize;
+            if (header->record_count > max_record_count || header->index_offset > file_size ||
+                (file_size - header->index_offset) / detail::kArchiveIndexEntrySize < header->record_count) {
+                return std::nullopt;
+            }
+            std::vector<std::byte> index_bytes(header->record_count * detail::kArchiveIndexEntrySize);
+            file.seekg(static_cast<std::streamoff>(header->index_offset));
+            file.read(reinterpret_cast<char *>(index_bytes.data()), static_cast<std::streamsize>(index_bytes.size()));
+            if (!file) {
+                return std::nullopt;
+            }
+            const std::span<const std::byte> entries{index_bytes};
+            for (std::size_t entry = 0; entry < header->record_count; ++entry) {
+                const auto entry_bytes = entries.subspan(entry * detail::kArchiveIndexEntrySize);
+                index.push_back({
+                    .key = detail::LoadLittleEndian(entry_bytes.subspan(0, 8)),
+                    .record = detail::LoadLittleEndian(entry_bytes.subspan(8, 8)),
+                });
+            }
+        } else {
+            const auto record_count = (file_size - detail::kArchiveHeaderSize) / detail::kArchiveRecordSize;
+            std::array<std::byte, 8> key_bytes{};
+            for (std::uint64_t record = 0; record < record_count; ++record) {
+                file.seekg(static_cast<std::streamoff>(detail::ArchiveRecordOffset(record)));
+                file.read(reinterpret_cast<char *>(key_bytes.data()), key_bytes.size());
+                if (!file) {
+                    return std::nullopt;
+                }
+                index.push_back({.key = detail::LoadLittleEndian(key_bytes), .record = record});
+            }
+        }
+    }
+
+    // the old index and a torn last record would be taken for records by the next recovery
+    if (file_size > detail::ArchiveRecordOffset(index.size())) {
+        std::filesystem::resize_file(path, detail::ArchiveRecordOffset(index.size()), error);
+        if (error) {
+            return std::nullopt;
+        }
+    }
+
+    std::array<std::byte, detail::kArchiveHeaderSize> header_bytes{};
+    detail::InsertArchiveHeader(header_bytes, {
+        .record_count = index.size(),
+        .index_offset = detail::kArchiveNotClosed,
+    });
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(header_bytes.data()), header_bytes.size());
+    file.seekp(static_cast<std::streamoff>(detail::ArchiveRecordOffset(index.size())));
+    if (!file) {
+        return std::nullopt;
+    }
+    return GameArchiveWriter{std::move(file), std::move(index)};
+}
+
+inline std::uint64_t GameArchiveWriter::Size() const noexcept {
+    return index_.size();
+}
+
+template<class T>
+void GameArchiveWriter::Append(const GameKey key, const Game<T> &game) {
+    std::array<std::byte, detail::kArchiveRecordSize> bytes{};
+    const std::span record_bytes{bytes};
+    detail::StoreLittleEndian(record_bytes.template first<8>(), key);
+    InsertGame(record_bytes.template subspan<8>(), game);
+    file_.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    index_.push_back({.key = key, .record = index_.size()});
+}
+
+inline InsertResult GameArchiveWriter::Close() {
+    if (!file_.is_open()) {
+        return InsertResult::Error;
+    }
+    // records of the same key stay in append order, so the reader can pick the latest one
+    std::sort(index_.begin(), index_.end(), [](const IndexEntry lhs, const IndexEntry rhs) {
+        return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.record < rhs.record);
+    });
+
+    const auto index_offset = detail::ArchiveRecordOffset(index_.size());
+    std::vector<std::byte> index_bytes(index_.size() * detail::kArchiveIndexEntrySize);
+    const std::span<std::byte> entries{index_bytes};
+    for (std::size_t entry = 0; entry < index_.size(); ++entry) {
+        const auto entry_bytes = entries.subspan(entry * detail::kArchiveIndexEntrySize);
+        detail::StoreLittleEndian(entry_bytes.subspan(0, 8), index_[entry].key);
+        detail::StoreLittleEndian(entry_bytes.subspan(8, 8), index_[entry].record);
+    }
+    file_.seekp(static_cast<std::streamoff>(index_offset));
+    file_.write(reinterpret_cast<const char *>(index_bytes.data()), static_cast<std::streamsize>(index_bytes.size()));
+
+    std::array<std::byte, detail::kArchiveHeaderSize> header_bytes{};
+    detail::InsertArchiveHeader(header_bytes, {
+        .record_count = index_.size(),
+        .index_offset = index_offset,
+    });
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char *>(header_bytes.data()), header_bytes.size());
+    file_.flush();
+    const auto is_written = static_cast<bool>(file_);
+    file_.close();
+    return is_written ? InsertResult::Success : InsertResult::Error;
+}
+
+inline GameArchiveReader::GameArchiveReader(const std::span<const std::byte> bytes) noexcept
+    : bytes_{bytes},
+      size_{detail::ExtractArchiveHeader(bytes)->record_count} {}
+
+inline GameArchiveReader::GameArchiveReader(GameArchiveReader &&other) noexcept
+    : bytes_{std::exchange(other.bytes_, {})},
+      size_{std::exchange(other.size_, 0)} {}
+
+inline GameArchiveReader &GameArchiveReader::operator=(GameArchiveReader &&other) noexcept {
+    std::swap(bytes_, other.bytes_);
+    std::swap(size_, other.size_);
+    return *this;
+}
+
+inline GameArchiveReader::~GameArchiveReader() {
+    if (!bytes_.empty()) {
+        ::munmap(const_cast<std::byte *>(bytes_.data()), bytes_.size());
+    }
+}
+
+inline std::optional<GameArchiveReader> GameArchiveReader::Open(const std::filesystem::path &path) {
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return std::nullopt;
+    }
+    struct stat status{};
+    if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < detail::kArchiveHeaderSize) {
+        ::close(descriptor);
+        return std::nullopt;
+    }
+    const auto file_size = static_cast<std::size_t>(status.st_size);
+    void *mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return std::nullopt;
+    }
+    const std::span bytes{static_cast<const std::byte *>(mapping), file_size};
+
+    // the count is bounded by what the file can hold before it is multiplied, so a crafted one cannot wrap
+    const auto header = detail::ExtractArchiveHeader(bytes);
+    const auto max_record_count = (file_size - detail::kArchiveHeaderSize) /
+        (detail::kArchiveRecordSize + detail::kArchiveIndexEntrySize);
+    const auto is_valid = header.has_value() &&
+        header->record_count <= max_record_count &&
+        header->index_offset == detail::ArchiveRecordOffset(header->record_count);
+    if (!is_valid) {
+        ::munmap(mapping, file_size);
+        return std::nullopt;
+    }
+    ::madvise(mapping, file_size, MADV_RANDOM);
+    return GameArchiveReader{bytes};
+}
+
+inline std::uint64_t GameArchiveReader::Size() const noexcept {
+    return size_;
+}
+
+inline GameKey GameArchiveReader::Key(const std::uint64_t record) const noexcept {
+    return detail::LoadLittleEndian(bytes_.subspan(detail::ArchiveRecordOffset(record), 8));
+}
+
+inline std::span<const std::byte, kBinaryGameSize> GameArchiveReader::Record(const std::uint64_t record) const noexcept {
+    return bytes_.subspan(detail::ArchiveRecordOffset(record) + 8).first<kBinaryGameSize>();
+}
+
+inline std::optional<std::uint64_t> GameArchiveReader::Find(const GameKey key) const noexcept {
+    const auto entries = bytes_.subspan(detail::ArchiveRecordOffset(size_), size_ * detail::kArchiveIndexEntrySize);
+    const auto entry_key = [entries](const std::uint64_t entry) {
+        return detail::LoadLittleEndian(entries.subspan(entry * detail::kArchiveIndexEntrySize, 8));
+    };
+
+    // the last entry of the key is the latest appended record
+    std::uint64_t first = 0;
+    std::uint64_t last = size_;
+    while (first < last) {
+        const auto middle = first + (last - first) / 2;
+        if (entry_key(middle) <= key) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    if (first == 0 || entry_key(first - 1) != key) {
+        return std::nullopt;
+    }
+    // the index comes from the file, a record it names past the records is corrupt
+    const auto record = detail::LoadLittleEndian(entries.subspan((first - 1) * detail::kArchiveIndexEntrySize + 8, 8));
+    if (record >= size_) {
+        return std::nullopt;
+    }
+    return record;
+}
+
+template<class T>
+ExtractResult GameArchiveReader::ExtractGame(const GameKey key, Game<T> &game) const noexcept {
+    const auto record = Find(key);
+    if (!record.has_value()) {
+        return ExtractResult::Error;
+    }
+    return serialization::ExtractGame(Record(*record), game);
+}
+
+}
+
+}
+
+#endif //HAMURABI_GAME_ARCHIVE_INL
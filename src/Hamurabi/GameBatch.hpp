@@ -0,0 +1,142 @@
+#ifndef HAMURABI_GAME_BATCH
+#define HAMURABI_GAME_BATCH
+
+#include <span>
+#include <vector>
+#include <optional>
+
+#include "Game.hpp"
+#include "DetailSimd.hpp"
+
+namespace hamurabi {
+
+template<class T>
+class GameBatch final {
+  public:
+    class Lane;
+
+    explicit GameBatch(std::vector<T> generators);
+
+    [[nodiscard]]
+    constexpr std::size_t Size() const noexcept;
+
+    [[nodiscard]]
+    constexpr Lane operator[](std::size_t lane) const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Round> CurrentRound() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const People> Population() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Acres> Area() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Bushels> Grain() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Bushels> AcrePrice() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const People> DeadFromHunger() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const People> DeadFromHungerInTotal() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const People> Arrived() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Bushels> GrainFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const Bushels> GrainEatenByRats() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::span<const std::uint8_t> IsPlague() const noexcept;
+
+    void PlayRoundBatch(std::span<const RoundInput> inputs, std::span<RoundResult> results);
+
+    [[nodiscard("result should be presented to the user")]]
+    std::optional<Statistics> Statistics(std::size_t lane) const noexcept;
+
+  private:
+    std::vector<People> population_;
+    std::vector<Acres> area_;
+    std::vector<Bushels> grain_;
+    std::vector<Bushels> acre_price_;
+    std::vector<People> dead_from_hunger_;
+    std::vector<People> dead_from_hunger_in_total_;
+    std::vector<People> arrived_;
+    std::vector<Bushels> grain_from_acre_;
+    std::vector<Bushels> grain_eaten_by_rats_;
+    std::vector<Round> current_round_;
+    std::vector<std::uint8_t> is_plague_;
+    std::vector<std::uint8_t> is_game_over_;
+    std::vector<T> generator_;
+    std::vector<detail::Distributions> distributions_;
+
+    std::vector<std::uint8_t> is_active_;
+    std::vector<Acres> area_to_buy_;
+    std::vector<Acres> area_to_sell_;
+    std::vector<Bushels> grain_to_feed_;
+    std::vector<Acres> area_to_plant_;
+    std::vector<Bushels> grain_to_plant_;
+    std::vector<Bushels> grain_left_;
+    std::vector<People> dead_;
+    std::vector<People> old_population_;
+    std::vector<std::uint8_t> becomes_game_over_;
+    std::vector<People> arrived_candidate_;
+};
+
+template<class T>
+class GameBatch<T>::Lane final {
+  public:
+    [[nodiscard]]
+    constexpr Round CurrentRound() const noexcept;
+
+    [[nodiscard]]
+    constexpr People Population() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres Area() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels Grain() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels AcrePrice() const noexcept;
+
+    [[nodiscard]]
+    constexpr People DeadFromHunger() const noexcept;
+
+    [[nodiscard]]
+    constexpr People DeadFromHungerInTotal() const noexcept;
+
+    [[nodiscard]]
+    constexpr People Arrived() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainEatenByRats() const noexcept;
+
+    [[nodiscard]]
+    constexpr bool IsPlague() const noexcept;
+
+  private:
+    friend class GameBatch;
+
+    constexpr Lane(const GameBatch &batch, std::size_t lane) noexcept;
+
+    const GameBatch *batch_;
+    std::size_t lane_;
+};
+
+}
+
+#include "GameBatch.inl"
+
+#endif //HAMURABI_GAME_BATCH
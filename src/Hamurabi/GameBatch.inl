@@ -0,0 +1,286 @@
+#ifndef HAMURABI_GAME_BATCH_INL
+#define HAMURABI_GAME_BATCH_INL
+
+#include <cassert>
+
+namespace hamurabi {
+
+template<class T>
+GameBatch<T>::GameBatch(std::vector<T> generators)
+    : population_(generators.size(), detail::kStartPopulation),
+      area_(generators.size(), detail::kStartArea),
+      grain_(generators.size(), detail::kStartGrain),
+      acre_price_(generators.size()),
+      dead_from_hunger_(generators.size(), detail::kStartDeadFromHunger),
+      dead_from_hunger_in_total_(generators.size(), detail::kStartDeadFromHunger),
+      arrived_(generators.size(), detail::kStartArrived),
+      grain_from_acre_(generators.size(), detail::kStartGrainFromAcre),
+      grain_eaten_by_rats_(generators.size(), detail::kStartGrainEatenByRats),
+      current_round_(generators.size(), detail::kFirstRound),
+      is_plague_(generators.size(), detail::kStartIsPlague),
+      is_game_over_(generators.size(), detail::kStartIsGameOver),
+      generator_{std::move(generators)},
+      distributions_(generator_.size()),
+      is_active_(generator_.size()),
+      area_to_buy_(generator_.size()),
+      area_to_sell_(generator_.size()),
+      grain_to_feed_(generator_.size()),
+      area_to_plant_(generator_.size()),
+      grain_to_plant_(generator_.size()),
+      grain_left_(generator_.size()),
+      dead_(generator_.size()),
+      old_population_(generator_.size()),
+      becomes_game_over_(generator_.size()),
+      arrived_candidate_(generator_.size()) {
+    for (std::size_t lane = 0; lane < Size(); ++lane) {
+        detail::SeekGenerator(generator_[lane], current_round_[lane], RandomEvent::AcrePrice);
+        acre_price_[lane] = detail::GenerateAcrePrice(generator_[lane], distributions_[lane]);
+    }
+}
+
+template<class T>
+constexpr std::size_t GameBatch<T>::Size() const noexcept {
+    return generator_.size();
+}
+
+template<class T>
+constexpr typename GameBatch<T>::Lane GameBatch<T>::operator[](const std::size_t lane) const noexcept {
+    return Lane{*this, lane};
+}
+
+template<class T>
+constexpr std::span<const Round> GameBatch<T>::CurrentRound() const noexcept {
+    return current_round_;
+}
+
+template<class T>
+constexpr std::span<const People> GameBatch<T>::Population() const noexcept {
+    return population_;
+}
+
+template<class T>
+constexpr std::span<const Acres> GameBatch<T>::Area() const noexcept {
+    return area_;
+}
+
+template<class T>
+constexpr std::span<const Bushels> GameBatch<T>::Grain() const noexcept {
+    return grain_;
+}
+
+template<class T>
+constexpr std::span<const Bushels> GameBatch<T>::AcrePrice() const noexcept {
+    return acre_price_;
+}
+
+template<class T>
+constexpr std::span<const People> GameBatch<T>::DeadFromHunger() const noexcept {
+    return dead_from_hunger_;
+}
+
+template<class T>
+constexpr std::span<const People> GameBatch<T>::DeadFromHungerInTotal() const noexcept {
+    return dead_from_hunger_in_total_;
+}
+
+template<class T>
+constexpr std::span<const People> GameBatch<T>::Arrived() const noexcept {
+    return arrived_;
+}
+
+template<class T>
+constexpr std::span<const Bushels> GameBatch<T>::GrainFromAcre() const noexcept {
+    return grain_from_acre_;
+}
+
+template<class T>
+constexpr std::span<const Bushels> GameBatch<T>::GrainEatenByRats() const noexcept {
+    return grain_eaten_by_rats_;
+}
+
+template<class T>
+constexpr std::span<const std::uint8_t> GameBatch<T>::IsPlague() const noexcept {
+    return is_plague_;
+}
+
+template<class T>
+void GameBatch<T>::PlayRoundBatch(const std::span<const RoundInput> inputs, const std::span<RoundResult> results) {
+    assert(inputs.size() == Size() && results.size() == Size());
+    const auto size = Size();
+
+    // finished games keep their state, the rest steps into the next round
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        if (is_game_over_[lane]) {
+            results[lane] = GameOver{(*this)[lane]};
+            is_active_[lane] = false;
+        } else if (current_round_[lane] > detail::kLastRound) {
+            results[lane] = GameEnd{};
+            is_active_[lane] = false;
+        } else {
+            is_active_[lane] = true;
+        }
+    }
+    // inactive lanes get empty input, so trading and planting become no-ops for them
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        const auto input = inputs[lane];
+        const bool is_active = is_active_[lane];
+        area_to_buy_[lane] = is_active ? static_cast<Acres>(input.AreaToBuy()) : 0;
+        area_to_sell_[lane] = is_active ? static_cast<Acres>(input.AreaToSell()) : 0;
+        grain_to_feed_[lane] = is_active ? static_cast<Bushels>(input.GrainToFeed()) : 0;
+        area_to_plant_[lane] = is_active ? static_cast<Acres>(input.AreaToPlant()) : 0;
+        current_round_[lane] += is_active;
+    }
+
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        area_[lane] += area_to_buy_[lane];
+        area_[lane] -= area_to_sell_[lane];
+        grain_[lane] -= area_to_buy_[lane] * acre_price_[lane];
+        grain_[lane] += area_to_sell_[lane] * acre_price_[lane];
+    }
+
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        if (is_active_[lane]) {
+            detail::SeekGenerator(generator_[lane], current_round_[lane], RandomEvent::GrainHarvestedFromAcre);
+            grain_from_acre_[lane] =
+                detail::GenerateGrainHarvestedFromAcre(generator_[lane], distributions_[lane]);
+        }
+    }
+    detail::simd::GrainToPlantArea(area_to_plant_, grain_to_plant_);
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        grain_[lane] += area_to_plant_[lane] * grain_from_acre_[lane];
+        grain_[lane] -= grain_to_plant_[lane];
+    }
+
+    // inactive lanes report no deaths out of a single person, so the game over check skips them
+    detail::simd::FeedPeople(population_, grain_to_feed_, grain_left_, dead_);
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        const bool is_active = is_active_[lane];
+        const auto dead = is_active ? dead_[lane] : 0;
+        dead_[lane] = dead;
+        old_population_[lane] = is_active ? population_[lane] : 1;
+        grain_[lane] += is_active ? grain_left_[lane] : 0;
+        grain_[lane] -= grain_to_feed_[lane];
+        dead_from_hunger_[lane] = is_active ? dead : dead_from_hunger_[lane];
+        population_[lane] -= dead;
+        dead_from_hunger_in_total_[lane] += dead;
+    }
+    detail::simd::IsGameOver(dead_, old_population_, becomes_game_over_);
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        if (becomes_game_over_[lane]) {
+            is_game_over_[lane] = true;
+            is_active_[lane] = false;
+            results[lane] = GameOver{(*this)[lane]};
+        }
+    }
+
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        if (!is_active_[lane]) {
+            continue;
+        }
+        detail::SeekGenerator(generator_[lane], current_round_[lane], RandomEvent::GrainEatenByRats);
+        grain_eaten_by_rats_[lane] =
+            detail::GenerateGrainEatenByRats(generator_[lane], distributions_[lane], grain_[lane]);
+        grain_[lane] -= grain_eaten_by_rats_[lane];
+    }
+
+    detail::simd::CountArrivedPeople(dead_from_hunger_, grain_from_acre_, grain_, arrived_candidate_);
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        const bool is_active = is_active_[lane];
+        arrived_[lane] = is_active ? arrived_candidate_[lane] : arrived_[lane];
+        population_[lane] += is_active ? arrived_candidate_[lane] : 0;
+    }
+
+    for (std::size_t lane = 0; lane < size; ++lane) {
+        if (!is_active_[lane]) {
+            continue;
+        }
+        detail::SeekGenerator(generator_[lane], current_round_[lane], RandomEvent::IsPlague);
+        is_plague_[lane] = detail::GenerateIsPlague(generator_[lane], distributions_[lane]);
+        if (is_plague_[lane]) {
+            population_[lane] /= 2;
+        }
+        detail::SeekGenerator(generator_[lane], current_round_[lane], RandomEvent::AcrePrice);
+        acre_price_[lane] = detail::GenerateAcrePrice(generator_[lane], distributions_[lane]);
+        // as in Game::PlayRound, an empty city after the last round is a game over
+        if (current_round_[lane] > detail::kLastRound && population_[lane] == 0) {
+            is_game_over_[lane] = true;
+            results[lane] = GameOver{(*this)[lane]};
+        } else if (current_round_[lane] > detail::kLastRound) {
+            results[lane] = GameEnd{};
+        } else {
+            results[lane] = Continue{};
+        }
+    }
+}
+
+template<class T>
+std::optional<Statistics> GameBatch<T>::Statistics(const std::size_t lane) const noexcept {
+    if (current_round_[lane] > detail::kLastRound && !is_game_over_[lane]) {
+        return hamurabi::Statistics{(*this)[lane]};
+    }
+    return std::nullopt;
+}
+
+template<class T>
+constexpr GameBatch<T>::Lane::Lane(const GameBatch &batch, const std::size_t lane) noexcept
+    : batch_{&batch},
+      lane_{lane} {}
+
+template<class T>
+constexpr Round GameBatch<T>::Lane::CurrentRound() const noexcept {
+    return batch_->current_round_[lane_];
+}
+
+template<class T>
+constexpr People GameBatch<T>::Lane::Population() const noexcept {
+    return batch_->population_[lane_];
+}
+
+template<class T>
+constexpr Acres GameBatch<T>::Lane::Area() const noexcept {
+    return batch_->area_[lane_];
+}
+
+template<class T>
+constexpr Bushels GameBatch<T>::Lane::Grain() const noexcept {
+    return batch_->grain_[lane_];
+}
+
+template<class T>
+constexpr Bushels GameBatch<T>::Lane::AcrePrice() const noexcept {
+    return batch_->acre_price_[lane_];
+}
+
+template<class T>
+constexpr People GameBatch<T>::Lane::DeadFromHunger() const noexcept {
+    return batch_->dead_from_hunger_[lane_];
+}
+
+template<class T>
+constexpr People GameBatch<T>::Lane::DeadFromHungerInTotal() const noexcept {
+    return batch_->dead_from_hunger_in_total_[lane_];
+}
+
+template<class T>
+constexpr People GameBatch<T>::Lane::Arrived() const noexcept {
+    return batch_->arrived_[lane_];
+}
+
+template<class T>
+constexpr Bushels GameBatch<T>::Lane::GrainFromAcre() const noexcept {
+    return batch_->grain_from_acre_[lane_];
+}
+
+template<class T>
+constexpr Bushels GameBatch<T>::Lane::GrainEatenByRats() const noexcept {
+    return batch_->grain_eaten_by_rats_[lane_];
+}
+
+template<class T>
+constexpr bool GameBatch<T>::Lane::IsPlague() const noexcept {
+    return batch_->is_plague_[lane_];
+}
+
+}
+
+#endif //HAMURABI_GAME_BATCH_INL
@@ -2,14 +2,14 @@
 #define HAMURABI_GAME_OVER
 
 #include "Resources.hpp"
-#include "Game.fwd"
+#include "GameState.hpp"
 
 namespace hamurabi {
 
 class GameOver final {
   public:
-    template<class T>
-    constexpr explicit GameOver(const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr explicit GameOver(const G &game) noexcept;
 
     [[nodiscard]]
     constexpr People DeadFromHunger() const noexcept;
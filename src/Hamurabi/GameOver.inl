@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr GameOver::GameOver(const Game<T> &game) noexcept
+template<GameState G>
+constexpr GameOver::GameOver(const G &game) noexcept
     : dead_from_hunger_{game.DeadFromHunger()} {}
 
 constexpr People GameOver::DeadFromHunger() const noexcept {
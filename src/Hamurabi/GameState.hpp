@@ -0,0 +1,27 @@
+#ifndef HAMURABI_GAME_STATE
+#define HAMURABI_GAME_STATE
+
+#include <concepts>
+
+#include "Resources.hpp"
+
+namespace hamurabi {
+
+template<class G>
+concept GameState = requires(const G &game) {
+    { game.CurrentRound() } -> std::convertible_to<Round>;
+    { game.Population() } -> std::convertible_to<People>;
+    { game.Area() } -> std::convertible_to<Acres>;
+    { game.Grain() } -> std::convertible_to<Bushels>;
+    { game.AcrePrice() } -> std::convertible_to<Bushels>;
+    { game.DeadFromHunger() } -> std::convertible_to<People>;
+    { game.DeadFromHungerInTotal() } -> std::convertible_to<People>;
+    { game.Arrived() } -> std::convertible_to<People>;
+    { game.GrainFromAcre() } -> std::convertible_to<Bushels>;
+    { game.GrainEatenByRats() } -> std::convertible_to<Bushels>;
+    { game.IsPlague() } -> std::convertible_to<bool>;
+};
+
+}
+
+#endif //HAMURABI_GAME_STATE
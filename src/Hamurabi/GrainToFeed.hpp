@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "NotEnoughGrain.hpp"
+#include "FeasibleRegion.hpp"
 
 namespace hamurabi {
 
@@ -12,8 +13,12 @@ using GrainToFeedResult = std::variant<GrainToFeed, NotEnoughGrain>;
 
 class GrainToFeed final {
   public:
-    template<class T>
-    constexpr static GrainToFeedResult New(Bushels grain_to_feed, const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr static GrainToFeedResult New(Bushels grain_to_feed, const G &game) noexcept;
+
+    // the same check against bounds computed for the game before
+    template<GameState G>
+    constexpr static GrainToFeedResult New(Bushels grain_to_feed, const G &game, const FeasibleRegion &region) noexcept;
 
     constexpr explicit operator Bushels() const noexcept;
 
@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr GrainToFeedResult GrainToFeed::New(const Bushels grain_to_feed, const Game<T> &game) noexcept {
+template<GameState G>
+constexpr GrainToFeedResult GrainToFeed::New(const Bushels grain_to_feed, const G &game) noexcept {
     const auto grain = game.Grain();
     if (grain_to_feed > grain) {
         return NotEnoughGrain{game};
@@ -12,6 +12,14 @@ constexpr GrainToFeedResult GrainToFeed::New(const Bushels grain_to_feed, const
     return GrainToFeed{grain_to_feed};
 }
 
+template<GameState G>
+constexpr GrainToFeedResult GrainToFeed::New(const Bushels grain_to_feed, const G &game, const FeasibleRegion &region) noexcept {
+    if (grain_to_feed > region.MaxGrainToFeed()) {
+        return NotEnoughGrain{game};
+    }
+    return GrainToFeed{grain_to_feed};
+}
+
 constexpr GrainToFeed::operator Bushels() const noexcept {
     return grain_to_feed_;
 }
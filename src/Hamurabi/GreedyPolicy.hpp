@@ -0,0 +1,21 @@
+#ifndef HAMURABI_GREEDY_POLICY
+#define HAMURABI_GREEDY_POLICY
+
+#include "RoundInput.hpp"
+#include "Detail.hpp"
+
+namespace hamurabi {
+
+// feeds everybody it can, then plants as much as grain and people allow, never trades land
+class GreedyPolicy final {
+  public:
+    template<GameState G>
+    [[nodiscard]]
+    constexpr RoundInput operator()(const G &game) const noexcept;
+};
+
+}
+
+#include "GreedyPolicy.inl"
+
+#endif //HAMURABI_GREEDY_POLICY
@@ -0,0 +1,27 @@
+#ifndef HAMURABI_GREEDY_POLICY_INL
+#define HAMURABI_GREEDY_POLICY_INL
+
+#include <algorithm>
+
+namespace hamurabi {
+
+template<GameState G>
+constexpr RoundInput GreedyPolicy::operator()(const G &game) const noexcept {
+    const auto &rules = detail::RulesOf(game);
+    const auto grain_to_feed = std::min(game.Grain(), game.Population() * rules.GrainPerPerson());
+    const auto area_to_plant = std::min({
+        game.Area(),
+        detail::AreaCanPlantWithGrain(game.Grain() - grain_to_feed, rules),
+        detail::AreaCanPlantWithPopulation(game.Population(), rules),
+    });
+    return std::get<RoundInput>(RoundInput::New(
+        std::get<AreaToBuy>(AreaToBuy::New(0, game)),
+        std::get<AreaToSell>(AreaToSell::New(0, game)),
+        std::get<GrainToFeed>(GrainToFeed::New(grain_to_feed, game)),
+        std::get<AreaToPlant>(AreaToPlant::New(area_to_plant, game)),
+        game));
+}
+
+}
+
+#endif //HAMURABI_GREEDY_POLICY_INL
@@ -0,0 +1,33 @@
+#include "Instantiations.hpp"
+#include "ParameterSweep.hpp"
+
+namespace hamurabi {
+
+template class Game<std::mt19937_64>;
+template class Game<CounterGenerator>;
+template class Game<std::mt19937_64, NoInstrumentation, RuntimeRules>;
+template class Game<CounterGenerator, NoInstrumentation, RuntimeRules>;
+template class Game<CounterGenerator, CountingInstrumentation>;
+template class Game<CounterGenerator, detail::SweepProbe, RuntimeRules>;
+
+}
+
+namespace hamurabi::serialization {
+
+template void InsertGame(std::ostream &, const Game<std::mt19937_64> &, Format);
+template ExtractResult ExtractGame(std::istream &, Game<std::mt19937_64> &, Format);
+template ExtractReport ExtractGame(std::string_view, Game<std::mt19937_64> &) noexcept;
+template void InsertGenerator(std::ostream &, const Game<std::mt19937_64> &);
+template ExtractResult ExtractGenerator(std::istream &, Game<std::mt19937_64> &);
+template void InsertGame(std::span<std::byte, kBinaryGameSize>, const Game<std::mt19937_64> &) noexcept;
+template ExtractResult ExtractGame(std::span<const std::byte, kBinaryGameSize>, Game<std::mt19937_64> &) noexcept;
+
+template void InsertGame(std::ostream &, const Game<CounterGenerator> &, Format);
+template ExtractResult ExtractGame(std::istream &, Game<CounterGenerator> &, Format);
+template ExtractReport ExtractGame(std::string_view, Game<CounterGenerator> &) noexcept;
+template void InsertGenerator(std::ostream &, const Game<CounterGenerator> &);
+template ExtractResult ExtractGenerator(std::istream &, Game<CounterGenerator> &);
+template void InsertGame(std::span<std::byte, kBinaryGameSize>, const Game<CounterGenerator> &) noexcept;
+template ExtractResult ExtractGame(std::span<const std::byte, kBinaryGameSize>, Game<CounterGenerator> &) noexcept;
+
+}
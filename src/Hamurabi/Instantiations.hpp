@@ -0,0 +1,42 @@
+#ifndef HAMURABI_INSTANTIATIONS
+#define HAMURABI_INSTANTIATIONS
+
+#include <random>
+
+#include "CounterGenerator.hpp"
+#include "Game.hpp"
+
+// the core library carries one optimized copy of these, consumers only declare them
+namespace hamurabi {
+
+extern template class Game<std::mt19937_64>;
+extern template class Game<CounterGenerator>;
+extern template class Game<std::mt19937_64, NoInstrumentation, RuntimeRules>;
+extern template class Game<CounterGenerator, NoInstrumentation, RuntimeRules>;
+extern template class Game<CounterGenerator, CountingInstrumentation>;
+
+}
+
+namespace hamurabi::serialization {
+
+extern template void InsertGame(std::ostream &, const Game<std::mt19937_64> &, Format);
+extern template ExtractResult ExtractGame(std::istream &, Game<std::mt19937_64> &, Format);
+extern template ExtractReport ExtractGame(std::string_view, Game<std::mt19937_64> &) noexcept;
+extern template void InsertGenerator(std::ostream &, const Game<std::mt19937_64> &);
+extern template ExtractResult ExtractGenerator(std::istream &, Game<std::mt19937_64> &);
+extern template void InsertGame(std::span<std::byte, kBinaryGameSize>, const Game<std::mt19937_64> &) noexcept;
+extern template ExtractResult ExtractGame(std::span<const std::byte, kBinaryGameSize>,
+                                          Game<std::mt19937_64> &) noexcept;
+
+extern template void InsertGame(std::ostream &, const Game<CounterGenerator> &, Format);
+extern template ExtractResult ExtractGame(std::istream &, Game<CounterGenerator> &, Format);
+extern template ExtractReport ExtractGame(std::string_view, Game<CounterGenerator> &) noexcept;
+extern template void InsertGenerator(std::ostream &, const Game<CounterGenerator> &);
+extern template ExtractResult ExtractGenerator(std::istream &, Game<CounterGenerator> &);
+extern template void InsertGame(std::span<std::byte, kBinaryGameSize>, const Game<CounterGenerator> &) noexcept;
+extern template ExtractResult ExtractGame(std::span<const std::byte, kBinaryGameSize>,
+                                          Game<CounterGenerator> &) noexcept;
+
+}
+
+#endif //HAMURABI_INSTANTIATIONS
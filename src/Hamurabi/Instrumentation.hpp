@@ -0,0 +1,135 @@
+#ifndef HAMURABI_INSTRUMENTATION
+#define HAMURABI_INSTRUMENTATION
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace hamurabi {
+
+enum class Phase : std::uint8_t {
+    Trade,
+    Harvest,
+    Feeding,
+    GameOverCheck,
+    Rats,
+    Arrivals,
+    Plague,
+    Price,
+};
+
+constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::Price) + 1;
+
+[[nodiscard]]
+static inline constexpr std::string_view PhaseName(Phase phase) noexcept;
+
+// the policy Game reports to, every call compiles to nothing
+class NoInstrumentation final {
+  public:
+    struct Scope final {};
+
+    [[nodiscard]]
+    constexpr Scope Measure(Phase phase) noexcept;
+
+    template<class T>
+    [[nodiscard]]
+    constexpr T &Draws(T &generator) noexcept;
+
+    constexpr void CountRound() noexcept;
+
+    constexpr void CountGameOver() noexcept;
+
+    constexpr void CountGameEnd() noexcept;
+};
+
+struct PhaseCounters final {
+    std::uint64_t calls;
+    std::chrono::nanoseconds time;
+};
+
+struct InstrumentationReport final {
+    std::array<PhaseCounters, kPhaseCount> phases;
+    std::uint64_t rounds;
+    std::uint64_t draws;
+    std::uint64_t game_overs;
+    std::uint64_t game_ends;
+
+    [[nodiscard]]
+    constexpr const PhaseCounters &operator[](Phase phase) const noexcept;
+
+    // reports of games of a batch add up
+    constexpr InstrumentationReport &operator+=(const InstrumentationReport &other) noexcept;
+};
+
+// times every phase of PlayRound with steady_clock and counts the draws from the generator
+class CountingInstrumentation final {
+  public:
+    class Scope final {
+      public:
+        Scope(InstrumentationReport &report, Phase phase) noexcept;
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope();
+
+      private:
+        PhaseCounters *counters_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    template<class T>
+    class CountingGenerator final {
+      public:
+        using result_type = typename T::result_type;
+
+        CountingGenerator(T &generator, std::uint64_t &draws) noexcept;
+
+        [[nodiscard]]
+        static constexpr result_type min() noexcept;
+
+        [[nodiscard]]
+        static constexpr result_type max() noexcept;
+
+        result_type operator()();
+
+      private:
+        T *generator_;
+        std::uint64_t *draws_;
+    };
+
+    [[nodiscard]]
+    Scope Measure(Phase phase) noexcept;
+
+    template<class T>
+    [[nodiscard]]
+    CountingGenerator<T> Draws(T &generator) noexcept;
+
+    constexpr void CountRound() noexcept;
+
+    constexpr void CountGameOver() noexcept;
+
+    constexpr void CountGameEnd() noexcept;
+
+    [[nodiscard]]
+    constexpr const InstrumentationReport &Report() const noexcept;
+
+    constexpr void Reset() noexcept;
+
+  private:
+    InstrumentationReport report_{};
+};
+
+// what a single Scope costs by itself, every phase time includes it once per call
+[[nodiscard]]
+static inline std::chrono::nanoseconds MeasureScopeOverhead();
+
+static inline void InsertReport(std::ostream &ostream, const InstrumentationReport &report);
+
+}
+
+#include "Instrumentation.inl"
+
+#endif //HAMURABI_INSTRUMENTATION
@@ -0,0 +1,167 @@
+#ifndef HAMURABI_INSTRUMENTATION_INL
+#define HAMURABI_INSTRUMENTATION_INL
+
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+namespace hamurabi {
+
+constexpr std::string_view PhaseName(const Phase phase) noexcept {
+    switch (phase) {
+        case Phase::Trade: {
+            return "trade";
+        }
+        case Phase::Harvest: {
+            return "harvest";
+        }
+        case Phase::Feeding: {
+            return "feeding";
+        }
+        case Phase::GameOverCheck: {
+            return "game over check";
+        }
+        case Phase::Rats: {
+            return "rats";
+        }
+        case Phase::Arrivals: {
+            return "arrivals";
+        }
+        case Phase::Plague: {
+            return "plague";
+        }
+        case Phase::Price: {
+            return "price";
+        }
+    }
+    return "unknown";
+}
+
+constexpr NoInstrumentation::Scope NoInstrumentation::Measure(Phase) noexcept {
+    return {};
+}
+
+template<class T>
+constexpr T &NoInstrumentation::Draws(T &generator) noexcept {
+    return generator;
+}
+
+constexpr void NoInstrumentation::CountRound() noexcept {}
+
+constexpr void NoInstrumentation::CountGameOver() noexcept {}
+
+constexpr void NoInstrumentation::CountGameEnd() noexcept {}
+
+constexpr const PhaseCounters &InstrumentationReport::operator[](const Phase phase) const noexcept {
+    return phases[static_cast<std::size_t>(phase)];
+}
+
+constexpr InstrumentationReport &InstrumentationReport::operator+=(const InstrumentationReport &other) noexcept {
+    for (std::size_t phase = 0; phase < kPhaseCount; ++phase) {
+        phases[phase].calls += other.phases[phase].calls;
+        phases[phase].time += other.phases[phase].time;
+    }
+    rounds += other.rounds;
+    draws += other.draws;
+    game_overs += other.game_overs;
+    game_ends += other.game_ends;
+    return *this;
+}
+
+inline CountingInstrumentation::Scope::Scope(InstrumentationReport &report, const Phase phase) noexcept
+    : counters_{&report.phases[static_cast<std::size_t>(phase)]},
+      start_{std::chrono::steady_clock::now()} {}
+
+inline CountingInstrumentation::Scope::~Scope() {
+    counters_->calls += 1;
+    counters_->time += std::chrono::steady_clock::now() - start_;
+}
+
+template<class T>
+CountingInstrumentation::CountingGenerator<T>::CountingGenerator(T &generator, std::uint64_t &draws) noexcept
+    : generator_{&generator},
+      draws_{&draws} {}
+
+template<class T>
+constexpr auto CountingInstrumentation::CountingGenerator<T>::min() noexcept -> result_type {
+    return T::min();
+}
+
+template<class T>
+constexpr auto CountingInstrumentation::CountingGenerator<T>::max() noexcept -> result_type {
+    return T::max();
+}
+
+template<class T>
+auto CountingInstrumentation::CountingGenerator<T>::operator()() -> result_type {
+    *draws_ += 1;
+    return (*generator_)();
+}
+
+inline CountingInstrumentation::Scope CountingInstrumentation::Measure(const Phase phase) noexcept {
+    return Scope{report_, phase};
+}
+
+template<class T>
+CountingInstrumentation::CountingGenerator<T> CountingInstrumentation::Draws(T &generator) noexcept {
+    return CountingGenerator<T>{generator, report_.draws};
+}
+
+constexpr void CountingInstrumentation::CountRound() noexcept {
+    report_.rounds += 1;
+}
+
+constexpr void CountingInstrumentation::CountGameOver() noexcept {
+    report_.game_overs += 1;
+}
+
+constexpr void CountingInstrumentation::CountGameEnd() noexcept {
+    report_.game_ends += 1;
+}
+
+constexpr const InstrumentationReport &CountingInstrumentation::Report() const noexcept {
+    return report_;
+}
+
+constexpr void CountingInstrumentation::Reset() noexcept {
+    report_ = {};
+}
+
+std::chrono::nanoseconds MeasureScopeOverhead() {
+    constexpr std::uint64_t kScopes = 1 << 16;
+    CountingInstrumentation instrumentation;
+    for (std::uint64_t scope = 0; scope < kScopes; ++scope) {
+        (void) instrumentation.Measure(Phase::Trade);
+    }
+    return instrumentation.Report()[Phase::Trade].time / kScopes;
+}
+
+void InsertReport(std::ostream &ostream, const InstrumentationReport &report) {
+    const auto overhead = static_cast<double>(MeasureScopeOverhead().count());
+    std::chrono::nanoseconds total{0};
+    for (const auto &phase : report.phases) {
+        total += phase.time;
+    }
+    std::ostringstream lines;
+    lines << "rounds " << report.rounds << ", draws " << report.draws
+          << ", game overs " << report.game_overs << ", game ends " << report.game_ends
+          << ", scope overhead " << overhead << " ns\n";
+    for (std::size_t index = 0; index < kPhaseCount; ++index) {
+        const auto &phase = report.phases[index];
+        const auto nanoseconds = static_cast<double>(phase.time.count());
+        const auto per_call = phase.calls == 0 ? 0.0 : nanoseconds / static_cast<double>(phase.calls);
+        lines << std::left << std::setw(16) << PhaseName(static_cast<Phase>(index)) << std::right
+              << std::setw(12) << phase.calls << " calls"
+              << std::setw(14) << phase.time.count() << " ns"
+              << std::fixed << std::setprecision(2)
+              << std::setw(10) << per_call << " ns/call"
+              << std::setw(10) << std::max(0.0, per_call - overhead) << " net"
+              << std::setw(8) << (total.count() == 0 ? 0.0 : 100 * nanoseconds / static_cast<double>(total.count()))
+              << "%\n";
+    }
+    ostream << std::move(lines).str();
+}
+
+}
+
+#endif //HAMURABI_INSTRUMENTATION_INL
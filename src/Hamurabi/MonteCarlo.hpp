@@ -0,0 +1,54 @@
+#ifndef HAMURABI_MONTE_CARLO
+#define HAMURABI_MONTE_CARLO
+
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "MonteCarloSummary.hpp"
+
+namespace hamurabi {
+
+template<class F, class T>
+concept GeneratorFactory = std::invocable<F &, std::uint64_t> &&
+    std::convertible_to<std::invoke_result_t<F &, std::uint64_t>, T>;
+
+struct MonteCarloOptions final {
+    std::uint64_t games = 0;
+    std::size_t threads = 0;
+    std::uint64_t chunk_size = 1024;
+};
+
+template<class T, GeneratorFactory<T> F, Policy<T> P>
+[[nodiscard]]
+MonteCarloSummary RunMonteCarlo(const MonteCarloOptions &options, F make_generator, P policy);
+
+namespace detail {
+
+struct GameRange final {
+    std::uint64_t first;
+    std::uint64_t last;
+};
+
+class WorkStealingQueue final {
+  public:
+    void Push(GameRange range);
+
+    [[nodiscard]]
+    std::optional<GameRange> Pop();
+
+    [[nodiscard]]
+    std::optional<GameRange> Steal();
+
+  private:
+    std::mutex mutex_;
+    std::deque<GameRange> ranges_;
+};
+
+}
+
+}
+
+#include "MonteCarlo.inl"
+
+#endif //HAMURABI_MONTE_CARLO
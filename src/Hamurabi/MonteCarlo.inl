@@ -0,0 +1,102 @@
+#ifndef HAMURABI_MONTE_CARLO_INL
+#define HAMURABI_MONTE_CARLO_INL
+
+#include <thread>
+#include <exception>
+
+namespace hamurabi {
+
+namespace detail {
+
+inline void WorkStealingQueue::Push(const GameRange range) {
+    const std::lock_guard lock{mutex_};
+    ranges_.push_back(range);
+}
+
+inline std::optional<GameRange> WorkStealingQueue::Pop() {
+    const std::lock_guard lock{mutex_};
+    if (ranges_.empty()) {
+        return std::nullopt;
+    }
+    const auto range = ranges_.back();
+    ranges_.pop_back();
+    return range;
+}
+
+inline std::optional<GameRange> WorkStealingQueue::Steal() {
+    const std::lock_guard lock{mutex_};
+    if (ranges_.empty()) {
+        return std::nullopt;
+    }
+    const auto range = ranges_.front();
+    ranges_.pop_front();
+    return range;
+}
+
+}
+
+template<class T, GeneratorFactory<T> F, Policy<T> P>
+MonteCarloSummary RunMonteCarlo(const MonteCarloOptions &options, F make_generator, P policy) {
+    const auto hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+    const auto thread_count = options.threads == 0 ? hardware_threads : options.threads;
+    const auto chunk_size = std::max<std::uint64_t>(1, options.chunk_size);
+
+    // every worker starts with a contiguous block of chunks and steals from the others when it runs out
+    std::vector<detail::WorkStealingQueue> queues(thread_count);
+    const auto chunk_count = options.games / chunk_size + (options.games % chunk_size != 0 ? 1 : 0);
+    for (std::uint64_t chunk = 0; chunk < chunk_count; ++chunk) {
+        const auto first = chunk * chunk_size;
+        const auto last = first + std::min(chunk_size, options.games - first);
+        queues[chunk * thread_count / chunk_count].Push({.first = first, .last = last});
+    }
+
+    // summaries only hold integer counts, so merging them is exact in any order
+    std::vector<MonteCarloSummary> summaries(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    const auto work = [&](const std::size_t worker) {
+        try {
+            auto worker_generator = make_generator;
+            auto worker_policy = policy;
+            while (true) {
+                auto range = queues[worker].Pop();
+                for (std::size_t offset = 1; !range && offset < thread_count; ++offset) {
+                    range = queues[(worker + offset) % thread_count].Steal();
+                }
+                if (!range) {
+                    return;
+                }
+                for (auto game_id = range->first; game_id < range->last; ++game_id) {
+                    Game<T> game{worker_generator(game_id)};
+                    summaries[worker].Add(PlayGame(game, worker_policy));
+                }
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (std::size_t worker = 1; worker < thread_count; ++worker) {
+        threads.emplace_back(work, worker);
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    MonteCarloSummary summary;
+    for (const auto &worker_summary : summaries) {
+        summary.Merge(worker_summary);
+    }
+    return summary;
+}
+
+}
+
+#endif //HAMURABI_MONTE_CARLO_INL
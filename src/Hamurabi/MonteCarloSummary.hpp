@@ -0,0 +1,57 @@
+#ifndef HAMURABI_MONTE_CARLO_SUMMARY
+#define HAMURABI_MONTE_CARLO_SUMMARY
+
+#include <map>
+#include <array>
+#include <ostream>
+
+#include "BatchSimulator.hpp"
+
+namespace hamurabi {
+
+class MonteCarloSummary final {
+  public:
+    void Add(const GameOutcome &outcome);
+
+    void Merge(const MonteCarloSummary &other);
+
+    [[nodiscard]]
+    constexpr std::uint64_t Games() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::uint64_t GameOverCount() const noexcept;
+
+    [[nodiscard]]
+    constexpr double GameOverRate() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::uint64_t RankCount(Rank rank) const noexcept;
+
+    [[nodiscard]]
+    double MeanAverageDeadFromHungerPercent() const noexcept;
+
+    [[nodiscard]]
+    People AverageDeadFromHungerPercentPercentile(double percentile) const noexcept;
+
+    [[nodiscard]]
+    double MeanAreaByPerson() const noexcept;
+
+    [[nodiscard]]
+    Acres AreaByPersonPercentile(double percentile) const noexcept;
+
+  private:
+    std::uint64_t games_ = 0;
+    std::uint64_t game_over_count_ = 0;
+    std::array<std::uint64_t, 4> rank_counts_{};
+    std::map<People, std::uint64_t> average_dead_from_hunger_percent_;
+    std::map<Acres, std::uint64_t> area_by_person_;
+};
+
+// game overs and ranks with their share, the distributions of finished games by mean and percentiles
+static inline void InsertSummary(std::ostream &ostream, const MonteCarloSummary &summary);
+
+}
+
+#include "MonteCarloSummary.inl"
+
+#endif //HAMURABI_MONTE_CARLO_SUMMARY
@@ -0,0 +1,144 @@
+#ifndef HAMURABI_MONTE_CARLO_SUMMARY_INL
+#define HAMURABI_MONTE_CARLO_SUMMARY_INL
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace hamurabi {
+
+namespace detail {
+
+constexpr std::size_t RankIndex(const Rank rank) noexcept {
+    return static_cast<std::size_t>(rank) - static_cast<std::size_t>(Rank::D);
+}
+
+template<class K>
+static inline double HistogramMean(const std::map<K, std::uint64_t> &histogram) noexcept {
+    std::uint64_t count = 0;
+    long double sum = 0;
+    for (const auto &[value, value_count] : histogram) {
+        count += value_count;
+        sum += static_cast<long double>(value) * static_cast<long double>(value_count);
+    }
+    if (count == 0) {
+        return 0;
+    }
+    return static_cast<double>(sum / static_cast<long double>(count));
+}
+
+// nearest-rank percentile, percentile is in range [0, 100]
+template<class K>
+static inline K HistogramPercentile(const std::map<K, std::uint64_t> &histogram, const double percentile) noexcept {
+    std::uint64_t count = 0;
+    for (const auto &[value, value_count] : histogram) {
+        count += value_count;
+    }
+    if (count == 0) {
+        return K{};
+    }
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count))));
+    std::uint64_t seen = 0;
+    for (const auto &[value, value_count] : histogram) {
+        seen += value_count;
+        if (seen >= rank) {
+            return value;
+        }
+    }
+    return histogram.rbegin()->first;
+}
+
+}
+
+inline void MonteCarloSummary::Add(const GameOutcome &outcome) {
+    games_ += 1;
+    if (std::holds_alternative<GameOver>(outcome)) {
+        game_over_count_ += 1;
+        return;
+    }
+    const auto &statistics = std::get<Statistics>(outcome);
+    rank_counts_[detail::RankIndex(statistics.Rank())] += 1;
+    average_dead_from_hunger_percent_[statistics.AverageDeadFromHungerPercent()] += 1;
+    area_by_person_[statistics.AreaByPerson()] += 1;
+}
+
+inline void MonteCarloSummary::Merge(const MonteCarloSummary &other) {
+    games_ += other.games_;
+    game_over_count_ += other.game_over_count_;
+    for (std::size_t index = 0; index < rank_counts_.size(); ++index) {
+        rank_counts_[index] += other.rank_counts_[index];
+    }
+    for (const auto &[value, count] : other.average_dead_from_hunger_percent_) {
+        average_dead_from_hunger_percent_[value] += count;
+    }
+    for (const auto &[value, count] : other.area_by_person_) {
+        area_by_person_[value] += count;
+    }
+}
+
+constexpr std::uint64_t MonteCarloSummary::Games() const noexcept {
+    return games_;
+}
+
+constexpr std::uint64_t MonteCarloSummary::GameOverCount() const noexcept {
+    return game_over_count_;
+}
+
+constexpr double MonteCarloSummary::GameOverRate() const noexcept {
+    if (games_ == 0) {
+        return 0;
+    }
+    return static_cast<double>(game_over_count_) / static_cast<double>(games_);
+}
+
+constexpr std::uint64_t MonteCarloSummary::RankCount(const Rank rank) const noexcept {
+    return rank_counts_[detail::RankIndex(rank)];
+}
+
+inline double MonteCarloSummary::MeanAverageDeadFromHungerPercent() const noexcept {
+    return detail::HistogramMean(average_dead_from_hunger_percent_);
+}
+
+inline People MonteCarloSummary::AverageDeadFromHungerPercentPercentile(const double percentile) const noexcept {
+    return detail::HistogramPercentile(average_dead_from_hunger_percent_, percentile);
+}
+
+inline double MonteCarloSummary::MeanAreaByPerson() const noexcept {
+    return detail::HistogramMean(area_by_person_);
+}
+
+inline Acres MonteCarloSummary::AreaByPersonPercentile(const double percentile) const noexcept {
+    return detail::HistogramPercentile(area_by_person_, percentile);
+}
+
+void InsertSummary(std::ostream &ostream, const MonteCarloSummary &summary) {
+    constexpr std::array<double, 5> percentiles = {10, 25, 50, 75, 90};
+    const auto games = static_cast<double>(std::max<std::uint64_t>(1, summary.Games()));
+
+    std::ostringstream lines;
+    lines << std::fixed << std::setprecision(2);
+    lines << "games " << summary.Games() << ", game overs " << summary.GameOverCount()
+          << ", game over rate " << 100 * summary.GameOverRate() << "%\n";
+    for (const auto [rank, letter] : {std::pair{Rank::A, 'A'}, std::pair{Rank::B, 'B'},
+                                      std::pair{Rank::C, 'C'}, std::pair{Rank::D, 'D'}}) {
+        lines << "rank " << letter << std::setw(12) << summary.RankCount(rank)
+              << std::setw(8) << 100 * static_cast<double>(summary.RankCount(rank)) / games << "%\n";
+    }
+    const auto insert_distribution = [&](const std::string_view name, const double mean, const auto percentile) {
+        lines << std::left << std::setw(34) << name << std::right << "mean " << mean;
+        for (const auto value : percentiles) {
+            lines << ", p" << static_cast<int>(value) << " " << (summary.*percentile)(value);
+        }
+        lines << "\n";
+    };
+    insert_distribution("average_dead_from_hunger_percent", summary.MeanAverageDeadFromHungerPercent(),
+                        &MonteCarloSummary::AverageDeadFromHungerPercentPercentile);
+    insert_distribution("area_by_person", summary.MeanAreaByPerson(), &MonteCarloSummary::AreaByPersonPercentile);
+    ostream << std::move(lines).str();
+}
+
+}
+
+#endif //HAMURABI_MONTE_CARLO_SUMMARY_INL
@@ -2,14 +2,14 @@
 #define HAMURABI_NOT_ENOUGH_AREA
 
 #include "Resources.hpp"
-#include "Game.fwd"
+#include "GameState.hpp"
 
 namespace hamurabi {
 
 class NotEnoughArea final {
   public:
-    template<class T>
-    constexpr explicit NotEnoughArea(const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr explicit NotEnoughArea(const G &game) noexcept;
 
     [[nodiscard]]
     constexpr Acres Area() const noexcept;
@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr NotEnoughArea::NotEnoughArea(const Game<T> &game) noexcept
+template<GameState G>
+constexpr NotEnoughArea::NotEnoughArea(const G &game) noexcept
     : area_{game.Area()} {}
 
 constexpr Acres NotEnoughArea::Area() const noexcept {
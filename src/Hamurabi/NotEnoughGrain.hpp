@@ -2,14 +2,14 @@
 #define HAMURABI_NOT_ENOUGH_GRAIN
 
 #include "Resources.hpp"
-#include "Game.fwd"
+#include "GameState.hpp"
 
 namespace hamurabi {
 
 class NotEnoughGrain final {
   public:
-    template<class T>
-    constexpr explicit NotEnoughGrain(const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr explicit NotEnoughGrain(const G &game) noexcept;
 
     [[nodiscard]]
     constexpr Bushels Grain() const noexcept;
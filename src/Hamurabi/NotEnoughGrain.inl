@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr NotEnoughGrain::NotEnoughGrain(const Game<T> &game) noexcept
+template<GameState G>
+constexpr NotEnoughGrain::NotEnoughGrain(const G &game) noexcept
     : grain_{game.Grain()} {}
 
 constexpr Bushels NotEnoughGrain::Grain() const noexcept {
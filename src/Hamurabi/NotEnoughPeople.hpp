@@ -2,14 +2,14 @@
 #define HAMURABI_NOT_ENOUGH_PEOPLE
 
 #include "Resources.hpp"
-#include "Game.fwd"
+#include "GameState.hpp"
 
 namespace hamurabi {
 
 class NotEnoughPeople final {
   public:
-    template<class T>
-    constexpr explicit NotEnoughPeople(const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr explicit NotEnoughPeople(const G &game) noexcept;
 
     [[nodiscard]]
     constexpr People Population() const noexcept;
@@ -3,8 +3,8 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr NotEnoughPeople::NotEnoughPeople(const Game<T> &game) noexcept
+template<GameState G>
+constexpr NotEnoughPeople::NotEnoughPeople(const G &game) noexcept
     : population_{game.Population()} {}
 
 constexpr People NotEnoughPeople::Population() const noexcept {
@@ -0,0 +1,165 @@
+#ifndef HAMURABI_PARAMETER_SWEEP
+#define HAMURABI_PARAMETER_SWEEP
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include "Rules.hpp"
+#include "MonteCarlo.hpp"
+#include "CounterGenerator.hpp"
+
+namespace hamurabi {
+
+struct AcrePriceBand final {
+    Bushels min;
+    Bushels max;
+};
+
+// an empty axis keeps the value of base
+struct SweepGrid final {
+    RuleValues base;
+    std::vector<Bushels> grain_per_person;
+    std::vector<std::uint_fast16_t> max_plague_can_occur_percent;
+    std::vector<People> min_dead_from_hunger_percent_to_game_over;
+    std::vector<AcrePriceBand> acre_price_band;
+};
+
+// the cartesian product of the axes, the last axis changes fastest, invalid combinations are left out
+[[nodiscard]]
+static inline std::vector<RuntimeRules> ExpandGrid(const SweepGrid &grid);
+
+// one row per variant, policy and game, column by column, rows are ordered by policy, then game, then variant
+struct SweepTable final {
+    std::vector<std::uint32_t> variant;
+    std::vector<std::uint32_t> policy;
+    std::vector<std::uint64_t> game;
+    std::vector<std::uint8_t> is_game_over;
+    std::vector<std::uint8_t> rank;
+    std::vector<Round> round;
+    std::vector<People> population;
+    std::vector<Acres> area;
+    std::vector<Bushels> grain;
+    std::vector<People> dead_from_hunger_in_total;
+    std::vector<People> average_dead_from_hunger_percent;
+    std::vector<Acres> area_by_person;
+    // rounds actually played against rounds the variants went through, the difference is what prefixes saved
+    std::uint64_t played_rounds = 0;
+    std::uint64_t variant_rounds = 0;
+
+    [[nodiscard]]
+    constexpr std::size_t Size() const noexcept;
+};
+
+namespace detail {
+
+// records what the plague phase drew, so a sweep can tell which plague chances would have agreed
+class SweepProbe final {
+  public:
+    using Scope = NoInstrumentation::Scope;
+
+    template<class T>
+    class RecordingGenerator final {
+      public:
+        using result_type = typename T::result_type;
+
+        RecordingGenerator(T &generator, SweepProbe &probe) noexcept;
+
+        [[nodiscard]]
+        static constexpr result_type min() noexcept;
+
+        [[nodiscard]]
+        static constexpr result_type max() noexcept;
+
+        result_type operator()();
+
+      private:
+        T *generator_;
+        SweepProbe *probe_;
+    };
+
+    [[nodiscard]]
+    constexpr Scope Measure(Phase phase) noexcept;
+
+    template<class T>
+    [[nodiscard]]
+    RecordingGenerator<T> Draws(T &generator) noexcept;
+
+    constexpr void CountRound() noexcept;
+
+    constexpr void CountGameOver() noexcept;
+
+    constexpr void CountGameEnd() noexcept;
+
+    // empty when the last round ended before the plague, nullopt when it drew more than fits
+    [[nodiscard]]
+    constexpr std::optional<std::span<const std::uint64_t>> PlagueDraws() const noexcept;
+
+  private:
+    constexpr void Record(std::uint64_t draw) noexcept;
+
+    Phase phase_ = Phase::Trade;
+    std::array<std::uint64_t, 4> plague_draws_{};
+    std::size_t plague_draw_count_ = 0;
+};
+
+// gives back recorded draws in order, with the range of T so distributions map them the same way
+template<class T>
+class ReplayGenerator final {
+  public:
+    using result_type = typename T::result_type;
+
+    constexpr explicit ReplayGenerator(std::span<const std::uint64_t> draws) noexcept;
+
+    [[nodiscard]]
+    static constexpr result_type min() noexcept;
+
+    [[nodiscard]]
+    static constexpr result_type max() noexcept;
+
+    constexpr result_type operator()() noexcept;
+
+  private:
+    std::span<const std::uint64_t> draws_;
+    std::size_t next_ = 0;
+};
+
+template<class T>
+using SweepGame = Game<T, SweepProbe, RuntimeRules>;
+
+}
+
+// the probe is declared here, so its game cannot be declared along the others in Instantiations.hpp
+extern template class Game<CounterGenerator, detail::SweepProbe, RuntimeRules>;
+
+namespace detail {
+
+// variants differing only here decide by comparing against the state and draws, so they can share a game
+[[nodiscard]]
+static inline bool IsSamePrefix(const RuleValues &lhs, const RuleValues &rhs) noexcept;
+
+// whether rules would have played the last round of game exactly as it went
+template<class T>
+[[nodiscard]]
+static inline bool IsSameRound(const SweepGame<T> &game, People old_population, const RuntimeRules &rules);
+
+template<class T>
+static inline void InsertRow(SweepTable &table, std::size_t row, const SweepGame<T> &game,
+                             const GameOutcome &outcome);
+
+}
+
+// every variant and policy plays the same games, so variants that differ only in plague chance or game over
+// percent play one game together until a round where their rules decide differently, there the game is forked;
+// policies must decide by the state and by rules outside of those two
+template<class T, GeneratorFactory<T> F, class P>
+requires std::invocable<P &, const detail::SweepGame<T> &>
+[[nodiscard]]
+SweepTable RunSweep(std::span<const RuntimeRules> variants, std::uint64_t games, F make_generator,
+                    std::span<P> policies);
+
+}
+
+#include "ParameterSweep.inl"
+
+#endif //HAMURABI_PARAMETER_SWEEP
@@ -0,0 +1,297 @@
+#ifndef HAMURABI_PARAMETER_SWEEP_INL
+#define HAMURABI_PARAMETER_SWEEP_INL
+
+#include <utility>
+#include <algorithm>
+
+namespace hamurabi {
+
+std::vector<RuntimeRules> ExpandGrid(const SweepGrid &grid) {
+    const auto axis = [](const auto &values, const auto base) {
+        return values.empty() ? std::vector{base} : values;
+    };
+    const auto grain_per_person = axis(grid.grain_per_person, grid.base.grain_per_person);
+    const auto plague_percent = axis(grid.max_plague_can_occur_percent, grid.base.max_plague_can_occur_percent);
+    const auto game_over_percent = axis(grid.min_dead_from_hunger_percent_to_game_over,
+                                        grid.base.min_dead_from_hunger_percent_to_game_over);
+    const auto acre_price_band = axis(grid.acre_price_band,
+                                      AcrePriceBand{.min = grid.base.min_acre_price, .max = grid.base.max_acre_price});
+
+    std::vector<RuntimeRules> variants;
+    variants.reserve(grain_per_person.size() * plague_percent.size() * game_over_percent.size() *
+                     acre_price_band.size());
+    for (const auto grain : grain_per_person) {
+        for (const auto plague : plague_percent) {
+            for (const auto game_over : game_over_percent) {
+                for (const auto band : acre_price_band) {
+                    auto values = grid.base;
+                    values.grain_per_person = grain;
+                    values.max_plague_can_occur_percent = plague;
+                    values.min_dead_from_hunger_percent_to_game_over = game_over;
+                    values.min_acre_price = band.min;
+                    values.max_acre_price = band.max;
+                    if (const auto rules = RuntimeRules::New(values)) {
+                        variants.push_back(*rules);
+                    }
+                }
+            }
+        }
+    }
+    return variants;
+}
+
+constexpr std::size_t SweepTable::Size() const noexcept {
+    return variant.size();
+}
+
+namespace detail {
+
+template<class T>
+SweepProbe::RecordingGenerator<T>::RecordingGenerator(T &generator, SweepProbe &probe) noexcept
+    : generator_{&generator},
+      probe_{&probe} {}
+
+template<class T>
+constexpr auto SweepProbe::RecordingGenerator<T>::min() noexcept -> result_type {
+    return T::min();
+}
+
+template<class T>
+constexpr auto SweepProbe::RecordingGenerator<T>::max() noexcept -> result_type {
+    return T::max();
+}
+
+template<class T>
+auto SweepProbe::RecordingGenerator<T>::operator()() -> result_type {
+    const auto draw = (*generator_)();
+    probe_->Record(static_cast<std::uint64_t>(draw));
+    return draw;
+}
+
+constexpr SweepProbe::Scope SweepProbe::Measure(const Phase phase) noexcept {
+    phase_ = phase;
+    return {};
+}
+
+template<class T>
+SweepProbe::RecordingGenerator<T> SweepProbe::Draws(T &generator) noexcept {
+    return RecordingGenerator<T>{generator, *this};
+}
+
+constexpr void SweepProbe::CountRound() noexcept {
+    plague_draw_count_ = 0;
+}
+
+constexpr void SweepProbe::CountGameOver() noexcept {}
+
+constexpr void SweepProbe::CountGameEnd() noexcept {}
+
+constexpr std::optional<std::span<const std::uint64_t>> SweepProbe::PlagueDraws() const noexcept {
+    if (plague_draw_count_ > plague_draws_.size()) {
+        return std::nullopt;
+    }
+    return std::span{plague_draws_}.first(plague_draw_count_);
+}
+
+constexpr void SweepProbe::Record(const std::uint64_t draw) noexcept {
+    if (phase_ != Phase::Plague) {
+        return;
+    }
+    if (plague_draw_count_ < plague_draws_.size()) {
+        plague_draws_[plague_draw_count_] = draw;
+    }
+    plague_draw_count_ += 1;
+}
+
+template<class T>
+constexpr ReplayGenerator<T>::ReplayGenerator(const std::span<const std::uint64_t> draws) noexcept
+    : draws_{draws} {}
+
+template<class T>
+constexpr auto ReplayGenerator<T>::min() noexcept -> result_type {
+    return T::min();
+}
+
+template<class T>
+constexpr auto ReplayGenerator<T>::max() noexcept -> result_type {
+    return T::max();
+}
+
+template<class T>
+constexpr auto ReplayGenerator<T>::operator()() noexcept -> result_type {
+    return static_cast<result_type>(draws_[next_++]);
+}
+
+bool IsSamePrefix(const RuleValues &lhs, const RuleValues &rhs) noexcept {
+    auto values = lhs;
+    values.max_plague_can_occur_percent = rhs.max_plague_can_occur_percent;
+    values.min_dead_from_hunger_percent_to_game_over = rhs.min_dead_from_hunger_percent_to_game_over;
+    return values == rhs;
+}
+
+template<class T>
+bool IsSameRound(const SweepGame<T> &game, const People old_population, const RuntimeRules &rules) {
+    const auto is_game_over = IsGameOver(game.DeadFromHunger(), old_population, game.Rules());
+    if (is_game_over != IsGameOver(game.DeadFromHunger(), old_population, rules)) {
+        return false;
+    }
+    if (is_game_over) {
+        return true;
+    }
+    const auto draws = game.Instrumentation().PlagueDraws();
+    if (!draws.has_value()) {
+        return rules.MaxPlagueCanOccurPercent() == game.Rules().MaxPlagueCanOccurPercent();
+    }
+    ReplayGenerator<T> replay{*draws};
+    Distributions distributions{};
+    return GenerateIsPlague(replay, distributions, rules) == game.IsPlague();
+}
+
+template<class T>
+void InsertRow(SweepTable &table, const std::size_t row, const SweepGame<T> &game, const GameOutcome &outcome) {
+    const auto statistics = std::get_if<Statistics>(&outcome);
+    table.is_game_over[row] = statistics == nullptr;
+    table.rank[row] = statistics == nullptr ? 0 : static_cast<std::uint8_t>(statistics->Rank());
+    table.round[row] = game.CurrentRound();
+    table.population[row] = game.Population();
+    table.area[row] = game.Area();
+    table.grain[row] = game.Grain();
+    table.dead_from_hunger_in_total[row] = game.DeadFromHungerInTotal();
+    table.average_dead_from_hunger_percent[row] =
+        statistics == nullptr ? 0 : statistics->AverageDeadFromHungerPercent();
+    table.area_by_person[row] = statistics == nullptr ? 0 : statistics->AreaByPerson();
+}
+
+}
+
+template<class T, GeneratorFactory<T> F, class P>
+requires std::invocable<P &, const detail::SweepGame<T> &>
+SweepTable RunSweep(const std::span<const RuntimeRules> variants, const std::uint64_t games, F make_generator,
+                    const std::span<P> policies) {
+    struct Group final {
+        detail::SweepGame<T> game;
+        std::vector<std::uint32_t> members;
+    };
+
+    std::vector<std::vector<std::uint32_t>> prefixes;
+    for (std::uint32_t variant = 0; variant < variants.size(); ++variant) {
+        const auto prefix = std::find_if(prefixes.begin(), prefixes.end(), [&](const auto &members) {
+            return detail::IsSamePrefix(variants[members.front()].Values(), variants[variant].Values());
+        });
+        if (prefix == prefixes.end()) {
+            prefixes.push_back({variant});
+        } else {
+            prefix->push_back(variant);
+        }
+    }
+
+    const auto size = policies.size() * games * variants.size();
+    SweepTable table{};
+    table.variant.resize(size);
+    table.policy.resize(size);
+    table.game.resize(size);
+    table.is_game_over.resize(size);
+    table.rank.resize(size);
+    table.round.resize(size);
+    table.population.resize(size);
+    table.area.resize(size);
+    table.grain.resize(size);
+    table.dead_from_hunger_in_total.resize(size);
+    table.average_dead_from_hunger_percent.resize(size);
+    table.area_by_person.resize(size);
+
+    std::vector<Group> pending;
+    for (std::uint32_t policy_index = 0; policy_index < policies.size(); ++policy_index) {
+        auto &policy = policies[policy_index];
+        for (std::uint64_t game_id = 0; game_id < games; ++game_id) {
+            const auto first_row = (policy_index * games + game_id) * variants.size();
+            const auto finish = [&](const detail::SweepGame<T> &game, const std::vector<std::uint32_t> &members,
+                                    const GameOutcome &outcome) {
+                for (const auto variant : members) {
+                    const auto row = first_row + variant;
+                    table.variant[row] = variant;
+                    table.policy[row] = policy_index;
+                    table.game[row] = game_id;
+                    detail::InsertRow(table, row, game, outcome);
+                }
+            };
+
+            for (const auto &members : prefixes) {
+                pending.push_back(Group{
+                    .game = detail::SweepGame<T>{make_generator(game_id), variants[members.front()]},
+                    .members = members,
+                });
+            }
+            while (!pending.empty()) {
+                auto group = std::move(pending.back());
+                pending.pop_back();
+                while (true) {
+                    // members that agree on both thresholds can never split, they need no copy before the round
+                    const auto &rules = group.game.Rules();
+                    const auto has_other_thresholds = [&](const auto variant) {
+                        const auto &values = variants[variant].Values();
+                        return values.max_plague_can_occur_percent != rules.MaxPlagueCanOccurPercent() ||
+                            values.min_dead_from_hunger_percent_to_game_over !=
+                                rules.MinDeadFromHungerPercentToGameOver();
+                    };
+                    const auto can_split =
+                        std::any_of(group.members.begin(), group.members.end(), has_other_thresholds);
+                    std::optional<detail::SweepGame<T>> before;
+                    if (can_split) {
+                        before.emplace(group.game.template Fork<detail::SweepProbe>(rules));
+                    }
+                    const auto old_population = group.game.Population();
+                    const RoundInput input = policy(std::as_const(group.game));
+                    auto result = group.game.PlayRound(input);
+                    table.played_rounds += 1;
+                    table.variant_rounds += group.members.size();
+
+                    if (can_split) {
+                        // whoever disagrees replays the round from the copy under its own rules, and splits again
+                        std::vector<std::uint32_t> rest;
+                        const auto split = [&](detail::SweepGame<T> &game, std::vector<std::uint32_t> &members) {
+                            const auto is_same_round = [&](const auto variant) {
+                                return detail::IsSameRound(game, old_population, variants[variant]);
+                            };
+                            const auto agrees = std::stable_partition(members.begin(), members.end(), is_same_round);
+                            rest.assign(agrees, members.end());
+                            members.erase(agrees, members.end());
+                        };
+                        split(group.game, group.members);
+                        while (!rest.empty()) {
+                            Group fork{
+                                .game = before->template Fork<detail::SweepProbe>(variants[rest.front()]),
+                                .members = std::move(rest),
+                            };
+                            rest = {};
+                            const auto fork_result = fork.game.PlayRound(input);
+                            table.played_rounds += 1;
+                            split(fork.game, fork.members);
+                            if (const auto game_over = std::get_if<GameOver>(&fork_result)) {
+                                finish(fork.game, fork.members, *game_over);
+                            } else if (std::holds_alternative<GameEnd>(fork_result)) {
+                                finish(fork.game, fork.members, fork.game.Statistics().value());
+                            } else {
+                                pending.push_back(std::move(fork));
+                            }
+                        }
+                    }
+
+                    if (const auto game_over = std::get_if<GameOver>(&result)) {
+                        finish(group.game, group.members, *game_over);
+                        break;
+                    }
+                    if (std::holds_alternative<GameEnd>(result)) {
+                        finish(group.game, group.members, group.game.Statistics().value());
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return table;
+}
+
+}
+
+#endif //HAMURABI_PARAMETER_SWEEP_INL
@@ -0,0 +1,17 @@
+#ifndef HAMURABI_POLICY
+#define HAMURABI_POLICY
+
+#include <concepts>
+
+#include "Game.fwd"
+#include "RoundInput.hpp"
+
+namespace hamurabi {
+
+template<class P, class T>
+concept Policy = std::invocable<P &, const Game<T> &> &&
+    std::convertible_to<std::invoke_result_t<P &, const Game<T> &>, RoundInput>;
+
+}
+
+#endif //HAMURABI_POLICY
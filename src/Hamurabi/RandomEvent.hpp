@@ -0,0 +1,17 @@
+#ifndef HAMURABI_RANDOM_EVENT
+#define HAMURABI_RANDOM_EVENT
+
+#include <cstdint>
+
+namespace hamurabi {
+
+enum class RandomEvent : std::uint8_t {
+    AcrePrice,
+    GrainHarvestedFromAcre,
+    GrainEatenByRats,
+    IsPlague,
+};
+
+}
+
+#endif //HAMURABI_RANDOM_EVENT
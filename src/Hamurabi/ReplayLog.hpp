@@ -0,0 +1,95 @@
+#ifndef HAMURABI_REPLAY_LOG
+#define HAMURABI_REPLAY_LOG
+
+#include <vector>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+
+#include "Game.hpp"
+
+namespace hamurabi {
+
+namespace serialization {
+
+struct ReplayLogOptions final {
+    Round snapshot_every_n_rounds = 0;
+};
+
+// the generator the game was made with, then one entry per played round, with an occasional snapshot to bound
+// the replay
+class ReplayLogWriter final {
+  public:
+    ReplayLogWriter(ReplayLogWriter &&other) noexcept = default;
+    ReplayLogWriter &operator=(ReplayLogWriter &&other) noexcept = default;
+
+    ReplayLogWriter(const ReplayLogWriter &) = delete;
+    ReplayLogWriter &operator=(const ReplayLogWriter &) = delete;
+
+    // the generator is the one the game is made with, a log being reopened must have been started with it
+    template<class T>
+    [[nodiscard]]
+    static std::optional<ReplayLogWriter> Open(const std::filesystem::path &path, const T &generator,
+                                               ReplayLogOptions options = {});
+
+    // nothing if the entry or a due snapshot could not be written, the round is not played then
+    template<class T>
+    [[nodiscard("result should be presented to the user")]]
+    std::optional<RoundResult> PlayRound(Game<T> &game, RoundInput input);
+
+    template<class T>
+    [[nodiscard]]
+    InsertResult Snapshot(const Game<T> &game);
+
+  private:
+    ReplayLogWriter(std::ofstream file, ReplayLogOptions options, Round rounds_since_snapshot);
+
+    [[nodiscard]]
+    InsertResult Write(std::span<const std::byte> bytes);
+
+    std::ofstream file_;
+    ReplayLogOptions options_;
+    Round rounds_since_snapshot_;
+};
+
+template<class T>
+[[nodiscard]]
+std::optional<Game<T>> ReplayGame(const std::filesystem::path &path);
+
+}
+
+namespace detail {
+
+struct ReplayInput final {
+    Acres area_to_buy;
+    Acres area_to_sell;
+    Bushels grain_to_feed;
+    Acres area_to_plant;
+};
+
+struct ReplayLogScan final {
+    std::span<const std::byte> generator;
+    std::size_t valid_size;
+    std::optional<std::span<const std::byte>> snapshot;
+    std::vector<ReplayInput> inputs;
+};
+
+static inline void InsertVarint(std::vector<std::byte> &bytes, std::uint64_t value);
+
+[[nodiscard]]
+static inline constexpr std::optional<std::uint64_t> ExtractVarint(std::span<const std::byte> bytes,
+                                                                   std::size_t &offset) noexcept;
+
+[[nodiscard]]
+static inline std::optional<std::vector<std::byte>> ReadFile(const std::filesystem::path &path);
+
+[[nodiscard]]
+static inline std::optional<ReplayLogScan> ScanReplayLog(std::span<const std::byte> bytes);
+
+}
+
+}
+
+#include "ReplayLog.inl"
+
+#endif //HAMURABI_REPLAY_LOG
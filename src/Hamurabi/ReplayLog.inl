@@ -0,0 +1,262 @@
+#ifndef HAMURABI_REPLAY_LOG_INL
+#define HAMURABI_REPLAY_LOG_INL
+
+#include <sstream>
+#include <algorithm>
+
+namespace hamurabi {
+
+namespace detail {
+
+inline constexpr std::array<std::byte, 4> kReplayLogMagic = {std::byte{'H'}, std::byte{'M'}, std::byte{'R'}, std::byte{'L'}};
+inline constexpr std::uint16_t kReplayLogVersion = 2;
+
+inline constexpr std::byte kReplayLogRoundTag{1};
+inline constexpr std::byte kReplayLogSnapshotTag{2};
+
+void InsertVarint(std::vector<std::byte> &bytes, std::uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::byte>(value));
+}
+
+constexpr std::optional<std::uint64_t> ExtractVarint(const std::span<const std::byte> bytes,
+                                                     std::size_t &offset) noexcept {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64 && offset < bytes.size(); shift += 7) {
+        const auto byte = std::to_integer<std::uint64_t>(bytes[offset++]);
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::vector<std::byte>> ReadFile(const std::filesystem::path &path) {
+    std::ifstream file{path, std::ifstream::binary | std::ifstream::ate};
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::vector<std::byte> bytes(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        return std::nullopt;
+    }
+    return bytes;
+}
+
+// a torn entry at the end is what a crash in the middle of a write leaves, so the log ends before it
+std::optional<ReplayLogScan> ScanReplayLog(const std::span<const std::byte> bytes) {
+    if (bytes.size() < 6 || !std::equal(kReplayLogMagic.begin(), kReplayLogMagic.end(), bytes.begin()) ||
+        LoadLittleEndian(bytes.subspan(4, 2)) != kReplayLogVersion) {
+        return std::nullopt;
+    }
+    std::size_t offset = 6;
+    const auto generator_size = ExtractVarint(bytes, offset);
+    if (!generator_size.has_value() || *generator_size > bytes.size() - offset) {
+        return std::nullopt;
+    }
+    const auto generator = bytes.subspan(offset, *generator_size);
+    offset += *generator_size;
+
+    ReplayLogScan scan{.generator = generator, .valid_size = offset, .snapshot = std::nullopt, .inputs = {}};
+    while (offset < bytes.size()) {
+        const auto tag = bytes[offset++];
+        if (tag == kReplayLogRoundTag) {
+            const auto area_to_buy = ExtractVarint(bytes, offset);
+            const auto area_to_sell = ExtractVarint(bytes, offset);
+            const auto grain_to_feed = ExtractVarint(bytes, offset);
+            const auto area_to_plant = ExtractVarint(bytes, offset);
+            if (!area_to_buy || !area_to_sell || !grain_to_feed || !area_to_plant) {
+                break;
+            }
+            scan.inputs.push_back({
+                .area_to_buy = static_cast<Acres>(*area_to_buy),
+                .area_to_sell = static_cast<Acres>(*area_to_sell),
+                .grain_to_feed = static_cast<Bushels>(*grain_to_feed),
+                .area_to_plant = static_cast<Acres>(*area_to_plant),
+            });
+        } else if (tag == kReplayLogSnapshotTag) {
+            const auto size = ExtractVarint(bytes, offset);
+            if (!size || *size < ser::kBinaryGameSize || *size > bytes.size() - offset) {
+                break;
+            }
+            scan.snapshot = bytes.subspan(offset, *size);
+            scan.inputs.clear();
+            offset += *size;
+        } else {
+            break;
+        }
+        scan.valid_size = offset;
+    }
+    return scan;
+}
+
+}
+
+namespace serialization {
+
+inline ReplayLogWriter::ReplayLogWriter(std::ofstream file, const ReplayLogOptions options,
+                                        const Round rounds_since_snapshot)
+    : file_{std::move(file)},
+      options_{options},
+      rounds_since_snapshot_{rounds_since_snapshot} {}
+
+template<class T>
+std::optional<ReplayLogWriter> ReplayLogWriter::Open(const std::filesystem::path &path, const T &generator,
+                                                     const ReplayLogOptions options) {
+    // the whole state of the generator, a seed alone would lose the game id of a CounterGenerator
+    std::ostringstream generator_text;
+    generator_text << generator;
+    const auto generator_string = std::move(generator_text).str();
+    const auto generator_bytes = std::as_bytes(std::span{generator_string});
+
+    std::error_code error;
+    if (std::filesystem::exists(path, error) && std::filesystem::file_size(path, error) != 0) {
+        const auto bytes = detail::ReadFile(path);
+        const auto scan = bytes ? detail::ScanReplayLog(*bytes) : std::nullopt;
+        if (!scan.has_value() || !std::ranges::equal(scan->generator, generator_bytes)) {
+            return std::nullopt;
+        }
+        std::filesystem::resize_file(path, scan->valid_size, error);
+        if (error) {
+            return std::nullopt;
+        }
+        std::ofstream file{path, std::ofstream::binary | std::ofstream::app};
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+        return ReplayLogWriter{std::move(file), options, static_cast<Round>(scan->inputs.size())};
+    }
+
+    std::ofstream file{path, std::ofstream::binary | std::ofstream::trunc};
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    ReplayLogWriter writer{std::move(file), options, 0};
+    std::vector<std::byte> header{detail::kReplayLogMagic.begin(), detail::kReplayLogMagic.end()};
+    header.resize(header.size() + 2);
+    detail::StoreLittleEndian(std::span{header}.last(2), detail::kReplayLogVersion);
+    detail::InsertVarint(header, generator_bytes.size());
+    header.insert(header.end(), generator_bytes.begin(), generator_bytes.end());
+    if (writer.Write(header) == InsertResult::Error) {
+        return std::nullopt;
+    }
+    return writer;
+}
+
+template<class T>
+std::optional<RoundResult> ReplayLogWriter::PlayRound(Game<T> &game, const RoundInput input) {
+    // a due snapshot is taken before the next round, so a failed one leaves the game as the log describes it
+    if (options_.snapshot_every_n_rounds != 0 && rounds_since_snapshot_ >= options_.snapshot_every_n_rounds &&
+        Snapshot(game) == InsertResult::Error) {
+        return std::nullopt;
+    }
+
+    std::vector<std::byte> entry{detail::kReplayLogRoundTag};
+    detail::InsertVarint(entry, static_cast<Acres>(input.AreaToBuy()));
+    detail::InsertVarint(entry, static_cast<Acres>(input.AreaToSell()));
+    detail::InsertVarint(entry, static_cast<Bushels>(input.GrainToFeed()));
+    detail::InsertVarint(entry, static_cast<Acres>(input.AreaToPlant()));
+    if (Write(entry) == InsertResult::Error) {
+        return std::nullopt;
+    }
+
+    rounds_since_snapshot_ += 1;
+    return game.PlayRound(input);
+}
+
+template<class T>
+InsertResult ReplayLogWriter::Snapshot(const Game<T> &game) {
+    std::array<std::byte, kBinaryGameSize> game_bytes{};
+    InsertGame(std::span{game_bytes}, game);
+    std::ostringstream generator;
+    InsertGenerator(generator, game);
+    const auto generator_text = std::move(generator).str();
+
+    std::vector<std::byte> entry{detail::kReplayLogSnapshotTag};
+    detail::InsertVarint(entry, game_bytes.size() + generator_text.size());
+    entry.insert(entry.end(), game_bytes.begin(), game_bytes.end());
+    for (const auto character : generator_text) {
+        entry.push_back(static_cast<std::byte>(character));
+    }
+    const auto result = Write(entry);
+    if (result == InsertResult::Success) {
+        rounds_since_snapshot_ = 0;
+    }
+    return result;
+}
+
+// every entry is flushed on its own, so the log is ahead of the game state it describes
+inline InsertResult ReplayLogWriter::Write(const std::span<const std::byte> bytes) {
+    file_.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file_.flush();
+    return file_ ? InsertResult::Success : InsertResult::Error;
+}
+
+template<class T>
+std::optional<Game<T>> ReplayGame(const std::filesystem::path &path) {
+    const auto bytes = detail::ReadFile(path);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    const auto scan = detail::ScanReplayLog(*bytes);
+    if (!scan.has_value()) {
+        return std::nullopt;
+    }
+
+    T generator{};
+    std::istringstream generator_text{std::string{reinterpret_cast<const char *>(scan->generator.data()),
+                                                  scan->generator.size()}};
+    if (!(generator_text >> generator)) {
+        return std::nullopt;
+    }
+
+    Game<T> game{generator};
+    if (scan->snapshot.has_value()) {
+        const auto snapshot = *scan->snapshot;
+        if (ExtractGame(snapshot.first<kBinaryGameSize>(), game) == ExtractResult::Error) {
+            return std::nullopt;
+        }
+        const auto generator_bytes = snapshot.subspan(kBinaryGameSize);
+        std::istringstream generator{std::string{reinterpret_cast<const char *>(generator_bytes.data()),
+                                                 generator_bytes.size()}};
+        if (ExtractGenerator(generator, game) == ExtractResult::Error) {
+            return std::nullopt;
+        }
+    }
+
+    // inputs go through the same validation as when they were played
+    for (const auto &replay_input : scan->inputs) {
+        const auto area_to_buy = AreaToBuy::New(replay_input.area_to_buy, game);
+        const auto area_to_sell = AreaToSell::New(replay_input.area_to_sell, game);
+        const auto grain_to_feed = GrainToFeed::New(replay_input.grain_to_feed, game);
+        const auto area_to_plant = AreaToPlant::New(replay_input.area_to_plant, game);
+        if (!std::holds_alternative<AreaToBuy>(area_to_buy) ||
+            !std::holds_alternative<AreaToSell>(area_to_sell) ||
+            !std::holds_alternative<GrainToFeed>(grain_to_feed) ||
+            !std::holds_alternative<AreaToPlant>(area_to_plant)) {
+            return std::nullopt;
+        }
+        const auto input = RoundInput::New(std::get<AreaToBuy>(area_to_buy),
+                                           std::get<AreaToSell>(area_to_sell),
+                                           std::get<GrainToFeed>(grain_to_feed),
+                                           std::get<AreaToPlant>(area_to_plant),
+                                           game);
+        if (!std::holds_alternative<RoundInput>(input)) {
+            return std::nullopt;
+        }
+        (void) game.PlayRound(std::get<RoundInput>(input));
+    }
+    return game;
+}
+
+}
+
+}
+
+#endif //HAMURABI_REPLAY_LOG_INL
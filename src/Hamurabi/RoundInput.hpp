@@ -15,12 +15,21 @@ using RoundInputResult = std::variant<RoundInput, NotEnoughArea, NotEnoughGrain,
 
 class RoundInput final {
   public:
-    template<class T>
+    template<GameState G>
     constexpr static RoundInputResult New(AreaToBuy area_to_buy,
                                           AreaToSell area_to_sell,
                                           GrainToFeed grain_to_feed,
                                           AreaToPlant area_to_plant,
-                                          const Game<T> &game) noexcept;
+                                          const G &game) noexcept;
+
+    // the same checks against bounds computed for the game before
+    template<GameState G>
+    constexpr static RoundInputResult New(AreaToBuy area_to_buy,
+                                          AreaToSell area_to_sell,
+                                          GrainToFeed grain_to_feed,
+                                          AreaToPlant area_to_plant,
+                                          const G &game,
+                                          const FeasibleRegion &region) noexcept;
 
     [[nodiscard]]
     constexpr AreaToBuy AreaToBuy() const;
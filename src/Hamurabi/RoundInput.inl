@@ -3,12 +3,12 @@
 
 namespace hamurabi {
 
-template<class T>
+template<GameState G>
 constexpr RoundInputResult RoundInput::New(const hamurabi::AreaToBuy area_to_buy,
                                            const hamurabi::AreaToSell area_to_sell,
                                            const hamurabi::GrainToFeed grain_to_feed,
                                            const hamurabi::AreaToPlant area_to_plant,
-                                           const Game <T> &game) noexcept {
+                                           const G &game) noexcept {
     const auto area = static_cast<detail::AcresSigned>(game.Area());
     const auto grain = static_cast<detail::BushelsSigned>(game.Grain());
     const auto acre_price = static_cast<detail::BushelsSigned>(game.AcrePrice());
@@ -23,7 +23,7 @@ constexpr RoundInputResult RoundInput::New(const hamurabi::AreaToBuy area_to_buy
         return NotEnoughArea{game};
     }
 
-    const auto grain_to_plant = static_cast<detail::BushelsSigned>(detail::GrainToPlantArea(area_to_plant_raw));
+    const auto grain_to_plant = static_cast<detail::BushelsSigned>(detail::GrainToPlantArea(area_to_plant_raw, detail::RulesOf(game)));
     const auto grain_needed = (area_to_buy_raw * acre_price) + grain_to_feed_raw +
         grain_to_plant - (area_to_sell_raw * acre_price);
     if (grain_needed > grain) {
@@ -33,6 +33,26 @@ constexpr RoundInputResult RoundInput::New(const hamurabi::AreaToBuy area_to_buy
     return RoundInput{area_to_buy, area_to_sell, grain_to_feed, area_to_plant};
 }
 
+template<GameState G>
+constexpr RoundInputResult RoundInput::New(const hamurabi::AreaToBuy area_to_buy,
+                                           const hamurabi::AreaToSell area_to_sell,
+                                           const hamurabi::GrainToFeed grain_to_feed,
+                                           const hamurabi::AreaToPlant area_to_plant,
+                                           const G &game,
+                                           const FeasibleRegion &region) noexcept {
+    const auto area_to_buy_raw = static_cast<Acres>(area_to_buy);
+    const auto area_to_sell_raw = static_cast<Acres>(area_to_sell);
+    const auto grain_to_feed_raw = static_cast<Bushels>(grain_to_feed);
+    const auto area_to_plant_raw = static_cast<Acres>(area_to_plant);
+    if (!region.HasAreaFor(area_to_buy_raw, area_to_sell_raw, area_to_plant_raw)) {
+        return NotEnoughArea{game};
+    }
+    if (!region.HasGrainFor(area_to_buy_raw, area_to_sell_raw, grain_to_feed_raw, area_to_plant_raw)) {
+        return NotEnoughGrain{game};
+    }
+    return RoundInput{area_to_buy, area_to_sell, grain_to_feed, area_to_plant};
+}
+
 constexpr AreaToBuy RoundInput::AreaToBuy() const {
     return area_to_buy_;
 }
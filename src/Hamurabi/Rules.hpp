@@ -0,0 +1,204 @@
+#ifndef HAMURABI_RULES
+#define HAMURABI_RULES
+
+#include <optional>
+
+#include "Resources.hpp"
+#include "Detail.hpp"
+#include "Rules.fwd"
+
+namespace hamurabi {
+
+// every rule is a constant, so the game arithmetic folds exactly as it did with the detail constants
+class DefaultRules final {
+  public:
+    [[nodiscard]]
+    static constexpr Round LastRound() noexcept;
+
+    [[nodiscard]]
+    static constexpr People StartPopulation() noexcept;
+
+    [[nodiscard]]
+    static constexpr Acres StartArea() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels StartGrain() noexcept;
+
+    [[nodiscard]]
+    static constexpr People StartArrived() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels StartGrainFromAcre() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels StartGrainEatenByRats() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MinAcrePrice() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MaxAcrePrice() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MinGrainHarvestedFromAcre() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MaxGrainHarvestedFromAcre() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MinGrainEatenByRatsFactor() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels MaxGrainEatenByRatsFactor() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels GrainEatenByRatsDivisor() noexcept;
+
+    [[nodiscard]]
+    static constexpr Acres AreaCanPlantWithBushel() noexcept;
+
+    [[nodiscard]]
+    static constexpr Acres AreaToPlantPerPerson() noexcept;
+
+    [[nodiscard]]
+    static constexpr Bushels GrainPerPerson() noexcept;
+
+    [[nodiscard]]
+    static constexpr People MinDeadFromHungerPercentToGameOver() noexcept;
+
+    [[nodiscard]]
+    static constexpr detail::PeopleSigned MinArrivedPeople() noexcept;
+
+    [[nodiscard]]
+    static constexpr detail::PeopleSigned MaxArrivedPeople() noexcept;
+
+    [[nodiscard]]
+    static constexpr std::uint_fast16_t MaxPlagueCanOccurPercent() noexcept;
+};
+
+// defaults are the rules of DefaultRules
+struct RuleValues final {
+    Round last_round = DefaultRules::LastRound();
+    People start_population = DefaultRules::StartPopulation();
+    Acres start_area = DefaultRules::StartArea();
+    Bushels start_grain = DefaultRules::StartGrain();
+    People start_arrived = DefaultRules::StartArrived();
+    Bushels start_grain_from_acre = DefaultRules::StartGrainFromAcre();
+    Bushels start_grain_eaten_by_rats = DefaultRules::StartGrainEatenByRats();
+    Bushels min_acre_price = DefaultRules::MinAcrePrice();
+    Bushels max_acre_price = DefaultRules::MaxAcrePrice();
+    Bushels min_grain_harvested_from_acre = DefaultRules::MinGrainHarvestedFromAcre();
+    Bushels max_grain_harvested_from_acre = DefaultRules::MaxGrainHarvestedFromAcre();
+    Bushels min_grain_eaten_by_rats_factor = DefaultRules::MinGrainEatenByRatsFactor();
+    Bushels max_grain_eaten_by_rats_factor = DefaultRules::MaxGrainEatenByRatsFactor();
+    Bushels grain_eaten_by_rats_divisor = DefaultRules::GrainEatenByRatsDivisor();
+    Acres area_can_plant_with_bushel = DefaultRules::AreaCanPlantWithBushel();
+    Acres area_to_plant_per_person = DefaultRules::AreaToPlantPerPerson();
+    Bushels grain_per_person = DefaultRules::GrainPerPerson();
+    People min_dead_from_hunger_percent_to_game_over = DefaultRules::MinDeadFromHungerPercentToGameOver();
+    detail::PeopleSigned min_arrived_people = DefaultRules::MinArrivedPeople();
+    detail::PeopleSigned max_arrived_people = DefaultRules::MaxArrivedPeople();
+    std::uint_fast16_t max_plague_can_occur_percent = DefaultRules::MaxPlagueCanOccurPercent();
+
+    friend constexpr bool operator==(const RuleValues &lhs, const RuleValues &rhs) noexcept = default;
+};
+
+// the same interface read from memory, for scenario variants chosen at run time
+class RuntimeRules final {
+  public:
+    constexpr RuntimeRules() noexcept = default;
+
+    // nullopt if a range is empty, a divisor or the acre price is zero or a percent leaves its scale
+    [[nodiscard]]
+    static constexpr std::optional<RuntimeRules> New(const RuleValues &values) noexcept;
+
+    [[nodiscard]]
+    constexpr const RuleValues &Values() const noexcept;
+
+    [[nodiscard]]
+    constexpr Round LastRound() const noexcept;
+
+    [[nodiscard]]
+    constexpr People StartPopulation() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres StartArea() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels StartGrain() const noexcept;
+
+    [[nodiscard]]
+    constexpr People StartArrived() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels StartGrainFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels StartGrainEatenByRats() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MinAcrePrice() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MaxAcrePrice() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MinGrainHarvestedFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MaxGrainHarvestedFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MinGrainEatenByRatsFactor() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels MaxGrainEatenByRatsFactor() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainEatenByRatsDivisor() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres AreaCanPlantWithBushel() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres AreaToPlantPerPerson() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainPerPerson() const noexcept;
+
+    [[nodiscard]]
+    constexpr People MinDeadFromHungerPercentToGameOver() const noexcept;
+
+    [[nodiscard]]
+    constexpr detail::PeopleSigned MinArrivedPeople() const noexcept;
+
+    [[nodiscard]]
+    constexpr detail::PeopleSigned MaxArrivedPeople() const noexcept;
+
+    [[nodiscard]]
+    constexpr std::uint_fast16_t MaxPlagueCanOccurPercent() const noexcept;
+
+  private:
+    constexpr explicit RuntimeRules(const RuleValues &values) noexcept;
+
+    RuleValues values_;
+};
+
+}
+
+namespace hamurabi::detail {
+
+// games without a Rules accessor, like batch lanes, play by the default rules
+template<class G>
+[[nodiscard]]
+constexpr static inline decltype(auto) RulesOf(const G &game) noexcept;
+
+template<class R>
+[[nodiscard]]
+static inline Distributions MakeDistributions(const R &rules);
+
+}
+
+#include "Rules.inl"
+
+#endif //HAMURABI_RULES
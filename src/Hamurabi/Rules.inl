@@ -0,0 +1,228 @@
+#ifndef HAMURABI_RULES_INL
+#define HAMURABI_RULES_INL
+
+namespace hamurabi {
+
+constexpr Round DefaultRules::LastRound() noexcept {
+    return detail::kLastRound;
+}
+
+constexpr People DefaultRules::StartPopulation() noexcept {
+    return detail::kStartPopulation;
+}
+
+constexpr Acres DefaultRules::StartArea() noexcept {
+    return detail::kStartArea;
+}
+
+constexpr Bushels DefaultRules::StartGrain() noexcept {
+    return detail::kStartGrain;
+}
+
+constexpr People DefaultRules::StartArrived() noexcept {
+    return detail::kStartArrived;
+}
+
+constexpr Bushels DefaultRules::StartGrainFromAcre() noexcept {
+    return detail::kStartGrainFromAcre;
+}
+
+constexpr Bushels DefaultRules::StartGrainEatenByRats() noexcept {
+    return detail::kStartGrainEatenByRats;
+}
+
+constexpr Bushels DefaultRules::MinAcrePrice() noexcept {
+    return detail::kMinAcrePrice;
+}
+
+constexpr Bushels DefaultRules::MaxAcrePrice() noexcept {
+    return detail::kMaxAcrePrice;
+}
+
+constexpr Bushels DefaultRules::MinGrainHarvestedFromAcre() noexcept {
+    return detail::kMinGrainHarvestedFromAcre;
+}
+
+constexpr Bushels DefaultRules::MaxGrainHarvestedFromAcre() noexcept {
+    return detail::kMaxGrainHarvestedFromAcre;
+}
+
+constexpr Bushels DefaultRules::MinGrainEatenByRatsFactor() noexcept {
+    return detail::kMinGrainEatenByRatsFactor;
+}
+
+constexpr Bushels DefaultRules::MaxGrainEatenByRatsFactor() noexcept {
+    return detail::kMaxGrainEatenByRatsFactor;
+}
+
+constexpr Bushels DefaultRules::GrainEatenByRatsDivisor() noexcept {
+    return detail::kGrainEatenByRatsDivisor;
+}
+
+constexpr Acres DefaultRules::AreaCanPlantWithBushel() noexcept {
+    return detail::kAreaCanPlantWithBushel;
+}
+
+constexpr Acres DefaultRules::AreaToPlantPerPerson() noexcept {
+    return detail::kAreaToPlantPerPerson;
+}
+
+constexpr Bushels DefaultRules::GrainPerPerson() noexcept {
+    return detail::kGrainPerPerson;
+}
+
+constexpr People DefaultRules::MinDeadFromHungerPercentToGameOver() noexcept {
+    return detail::kMinDeadFromHungerPercentToGameOver;
+}
+
+constexpr detail::PeopleSigned DefaultRules::MinArrivedPeople() noexcept {
+    return detail::kMinArrivedPeople;
+}
+
+constexpr detail::PeopleSigned DefaultRules::MaxArrivedPeople() noexcept {
+    return detail::kMaxArrivedPeople;
+}
+
+constexpr std::uint_fast16_t DefaultRules::MaxPlagueCanOccurPercent() noexcept {
+    return detail::kMaxPlagueCanOccurPercent;
+}
+
+constexpr std::optional<RuntimeRules> RuntimeRules::New(const RuleValues &values) noexcept {
+    const auto is_valid = values.last_round >= detail::kFirstRound &&
+        values.start_population > 0 &&
+        values.min_acre_price > 0 &&
+        values.min_acre_price <= values.max_acre_price &&
+        values.min_grain_harvested_from_acre <= values.max_grain_harvested_from_acre &&
+        values.min_grain_eaten_by_rats_factor <= values.max_grain_eaten_by_rats_factor &&
+        values.grain_eaten_by_rats_divisor > 0 &&
+        values.area_can_plant_with_bushel > 0 &&
+        values.grain_per_person > 0 &&
+        values.min_dead_from_hunger_percent_to_game_over <= detail::kMaxDeadFromHungerPercent &&
+        values.min_arrived_people >= 0 &&
+        values.min_arrived_people <= values.max_arrived_people &&
+        values.max_plague_can_occur_percent <= detail::kMaxPlaguePercent;
+    if (!is_valid) {
+        return std::nullopt;
+    }
+    return RuntimeRules{values};
+}
+
+constexpr const RuleValues &RuntimeRules::Values() const noexcept {
+    return values_;
+}
+
+constexpr Round RuntimeRules::LastRound() const noexcept {
+    return values_.last_round;
+}
+
+constexpr People RuntimeRules::StartPopulation() const noexcept {
+    return values_.start_population;
+}
+
+constexpr Acres RuntimeRules::StartArea() const noexcept {
+    return values_.start_area;
+}
+
+constexpr Bushels RuntimeRules::StartGrain() const noexcept {
+    return values_.start_grain;
+}
+
+constexpr People RuntimeRules::StartArrived() const noexcept {
+    return values_.start_arrived;
+}
+
+constexpr Bushels RuntimeRules::StartGrainFromAcre() const noexcept {
+    return values_.start_grain_from_acre;
+}
+
+constexpr Bushels RuntimeRules::StartGrainEatenByRats() const noexcept {
+    return values_.start_grain_eaten_by_rats;
+}
+
+constexpr Bushels RuntimeRules::MinAcrePrice() const noexcept {
+    return values_.min_acre_price;
+}
+
+constexpr Bushels RuntimeRules::MaxAcrePrice() const noexcept {
+    return values_.max_acre_price;
+}
+
+constexpr Bushels RuntimeRules::MinGrainHarvestedFromAcre() const noexcept {
+    return values_.min_grain_harvested_from_acre;
+}
+
+constexpr Bushels RuntimeRules::MaxGrainHarvestedFromAcre() const noexcept {
+    return values_.max_grain_harvested_from_acre;
+}
+
+constexpr Bushels RuntimeRules::MinGrainEatenByRatsFactor() const noexcept {
+    return values_.min_grain_eaten_by_rats_factor;
+}
+
+constexpr Bushels RuntimeRules::MaxGrainEatenByRatsFactor() const noexcept {
+    return values_.max_grain_eaten_by_rats_factor;
+}
+
+constexpr Bushels RuntimeRules::GrainEatenByRatsDivisor() const noexcept {
+    return values_.grain_eaten_by_rats_divisor;
+}
+
+constexpr Acres RuntimeRules::AreaCanPlantWithBushel() const noexcept {
+    return values_.area_can_plant_with_bushel;
+}
+
+constexpr Acres RuntimeRules::AreaToPlantPerPerson() const noexcept {
+    return values_.area_to_plant_per_person;
+}
+
+constexpr Bushels RuntimeRules::GrainPerPerson() const noexcept {
+    return values_.grain_per_person;
+}
+
+constexpr People RuntimeRules::MinDeadFromHungerPercentToGameOver() const noexcept {
+    return values_.min_dead_from_hunger_percent_to_game_over;
+}
+
+constexpr detail::PeopleSigned RuntimeRules::MinArrivedPeople() const noexcept {
+    return values_.min_arrived_people;
+}
+
+constexpr detail::PeopleSigned RuntimeRules::MaxArrivedPeople() const noexcept {
+    return values_.max_arrived_people;
+}
+
+constexpr std::uint_fast16_t RuntimeRules::MaxPlagueCanOccurPercent() const noexcept {
+    return values_.max_plague_can_occur_percent;
+}
+
+constexpr RuntimeRules::RuntimeRules(const RuleValues &values) noexcept
+    : values_{values} {}
+
+}
+
+namespace hamurabi::detail {
+
+template<class G>
+constexpr decltype(auto) RulesOf(const G &game) noexcept {
+    if constexpr (requires { game.Rules(); }) {
+        return game.Rules();
+    } else {
+        return DefaultRules{};
+    }
+}
+
+template<class R>
+Distributions MakeDistributions(const R &rules) {
+    using BushelsDistribution = std::uniform_int_distribution<Bushels>;
+    return {
+        .acre_price = BushelsDistribution{rules.MinAcrePrice(), rules.MaxAcrePrice()},
+        .grain_harvested_from_acre = BushelsDistribution{rules.MinGrainHarvestedFromAcre(),
+                                                         rules.MaxGrainHarvestedFromAcre()},
+        .grain_eaten_by_rats = BushelsDistribution{rules.MinGrainEatenByRatsFactor(),
+                                                   rules.MaxGrainEatenByRatsFactor()},
+    };
+}
+
+}
+
+#endif //HAMURABI_RULES_INL
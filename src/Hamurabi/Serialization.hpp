@@ -1,8 +1,11 @@
 #ifndef HAMURABI_SERIALIZATION
 #define HAMURABI_SERIALIZATION
 
+#include <span>
+#include <cstddef>
 #include <istream>
 #include <ostream>
+#include <string_view>
 
 #include "Game.fwd"
 
@@ -10,19 +13,53 @@ namespace hamurabi::serialization {
 
 enum class Format : std::uint8_t {
     YAML,
+    Binary,
 };
 
-template<class T>
-void InsertGame(std::ostream &ostream, const Game<T> &game, Format format);
+// magic, version and size, ten fields, flags with padding, checksum
+constexpr std::size_t kBinaryGameSize = 8 + 10 * 8 + 8 + 8;
+
+template<class T, class I, class R>
+void InsertGame(std::ostream &ostream, const Game<T, I, R> &game, Format format);
+
+enum class InsertResult : std::uint8_t {
+    Success,
+    Error,
+};
 
 enum class ExtractResult : std::uint8_t {
     Success,
     Error,
 };
 
-template<class T>
+template<class T, class I, class R>
+[[nodiscard]]
+ExtractResult ExtractGame(std::istream &istream, Game<T, I, R> &game, Format format);
+
+// offset is where extraction stopped, so on error it points at the offending byte
+struct ExtractReport final {
+    ExtractResult result;
+    std::size_t offset;
+};
+
+template<class T, class I, class R>
+[[nodiscard]]
+ExtractReport ExtractGame(std::string_view string, Game<T, I, R> &game) noexcept;
+
+// generator and distributions are not part of a save, these carry them through the stream operators of T
+template<class T, class I, class R>
+void InsertGenerator(std::ostream &ostream, const Game<T, I, R> &game);
+
+template<class T, class I, class R>
+[[nodiscard]]
+ExtractResult ExtractGenerator(std::istream &istream, Game<T, I, R> &game);
+
+template<class T, class I, class R>
+void InsertGame(std::span<std::byte, kBinaryGameSize> bytes, const Game<T, I, R> &game) noexcept;
+
+template<class T, class I, class R>
 [[nodiscard]]
-ExtractResult ExtractGame(std::istream &istream, Game<T> &game, Format format);
+ExtractResult ExtractGame(std::span<const std::byte, kBinaryGameSize> bytes, Game<T, I, R> &game) noexcept;
 
 }
 
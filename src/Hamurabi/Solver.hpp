@@ -0,0 +1,144 @@
+#ifndef HAMURABI_SOLVER
+#define HAMURABI_SOLVER
+
+#include <array>
+#include <ostream>
+#include <unordered_map>
+
+#include "Game.hpp"
+
+namespace hamurabi {
+
+enum class Objective : std::uint8_t {
+    ExpectedRank,
+    Survival,
+};
+
+struct SolverOptions final {
+    Objective objective = Objective::ExpectedRank;
+    People population_step = 20;
+    Acres area_step = 200;
+    Bushels grain_step = 500;
+    std::uint_fast8_t trade_levels = 1;
+    std::uint_fast8_t feed_levels = 3;
+    std::uint_fast8_t plant_levels = 2;
+    // 0 leaves the values uncapped
+    std::size_t max_cache_entries = 0;
+    // the policy keeps an entry for every decision taken, so a capped solver records none whatever this says
+    bool record_policy = true;
+};
+
+struct SolverAction final {
+    std::int_fast8_t trade;
+    std::uint_fast8_t feed;
+    std::uint_fast8_t plant;
+};
+
+class Solver final {
+  public:
+    explicit Solver(SolverOptions options);
+
+    [[nodiscard]]
+    constexpr const SolverOptions &Options() const noexcept;
+
+    [[nodiscard]]
+    double Solve();
+
+    [[nodiscard]]
+    double Value(Round round, People population, Acres area, Bushels grain, People dead_in_total);
+
+    [[nodiscard]]
+    SolverAction Decide(Round round, People population, Acres area, Bushels grain,
+                        Bushels acre_price, People dead_in_total);
+
+    template<GameState G>
+    [[nodiscard]]
+    RoundInput Decide(const G &game);
+
+    [[nodiscard]]
+    std::size_t CacheSize() const noexcept;
+
+    [[nodiscard]]
+    std::size_t PolicySize() const noexcept;
+
+    void InsertPolicy(std::ostream &ostream) const;
+
+  private:
+    using Key = std::uint64_t;
+
+    struct State final {
+        Round round;
+        People population;
+        Acres area;
+        Bushels grain;
+        std::uint_fast8_t dead_in_total;
+    };
+
+    // acre prices come from the rules of the game asked, so the policy keeps them whole
+    struct PolicyKey final {
+        Key state;
+        Bushels acre_price;
+
+        friend constexpr bool operator==(const PolicyKey &lhs, const PolicyKey &rhs) noexcept = default;
+    };
+
+    struct PolicyKeyHash final {
+        [[nodiscard]]
+        std::size_t operator()(const PolicyKey &key) const noexcept;
+    };
+
+    struct Decision final {
+        double value;
+        SolverAction action;
+    };
+
+    using Cache = std::unordered_map<Key, Decision>;
+
+    [[nodiscard]]
+    State Quantize(Round round, People population, Acres area, Bushels grain, People dead_in_total) const noexcept;
+
+    [[nodiscard]]
+    static Key Pack(const State &state) noexcept;
+
+    [[nodiscard]]
+    double StateValue(const State &state);
+
+    [[nodiscard]]
+    Decision Best(const State &state, Bushels acre_price);
+
+    [[nodiscard]]
+    Decision BestWithoutTrade(const State &state);
+
+    [[nodiscard]]
+    Decision BestForTrade(const State &state, Bushels acre_price, std::int_fast8_t trade);
+
+    [[nodiscard]]
+    double ActionValue(const State &state, Bushels acre_price, SolverAction action);
+
+    [[nodiscard]]
+    double TerminalValue(People population, Acres area, People dead_in_total) const noexcept;
+
+    void Remember(Cache &cache, Round round, Key key, Decision decision);
+
+    SolverOptions options_;
+    std::array<Cache, 16> values_;
+    std::array<Cache, 16> values_without_trade_;
+    std::unordered_map<PolicyKey, SolverAction, PolicyKeyHash> policy_;
+};
+
+class SolverPolicy final {
+  public:
+    explicit SolverPolicy(Solver &solver) noexcept;
+
+    template<GameState G>
+    RoundInput operator()(const G &game) const;
+
+  private:
+    Solver *solver_;
+};
+
+}
+
+#include "Solver.inl"
+
+#endif //HAMURABI_SOLVER
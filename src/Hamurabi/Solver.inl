@@ -0,0 +1,491 @@
+#ifndef HAMURABI_SOLVER_INL
+#define HAMURABI_SOLVER_INL
+
+#include <tuple>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace hamurabi {
+
+namespace detail {
+
+// dead in total only matters for the rank through its thresholds, so it is kept as the index of one of these
+inline constexpr std::array<People, 4> kSolverDeadInTotalBuckets = {0, 40, 110, 340};
+
+inline constexpr Bushels kSolverMinFeedPercent = 60;
+inline constexpr Bushels kSolverMaxFeedPercent = 100;
+
+inline constexpr double kSolverGameOverValue = 0;
+inline constexpr double kSolverSurvivedValue = 1;
+
+struct SolverState final {
+    Round round;
+    People population;
+    Acres area;
+    Bushels grain;
+    Bushels acre_price;
+    People dead_in_total;
+
+    [[nodiscard]]
+    constexpr Round CurrentRound() const noexcept;
+
+    [[nodiscard]]
+    constexpr People Population() const noexcept;
+
+    [[nodiscard]]
+    constexpr Acres Area() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels Grain() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels AcrePrice() const noexcept;
+
+    [[nodiscard]]
+    constexpr People DeadFromHunger() const noexcept;
+
+    [[nodiscard]]
+    constexpr People DeadFromHungerInTotal() const noexcept;
+
+    [[nodiscard]]
+    constexpr People Arrived() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainFromAcre() const noexcept;
+
+    [[nodiscard]]
+    constexpr Bushels GrainEatenByRats() const noexcept;
+
+    [[nodiscard]]
+    constexpr bool IsPlague() const noexcept;
+};
+
+constexpr Round SolverState::CurrentRound() const noexcept {
+    return round;
+}
+
+constexpr People SolverState::Population() const noexcept {
+    return population;
+}
+
+constexpr Acres SolverState::Area() const noexcept {
+    return area;
+}
+
+constexpr Bushels SolverState::Grain() const noexcept {
+    return grain;
+}
+
+constexpr Bushels SolverState::AcrePrice() const noexcept {
+    return acre_price;
+}
+
+constexpr People SolverState::DeadFromHunger() const noexcept {
+    return kStartDeadFromHunger;
+}
+
+constexpr People SolverState::DeadFromHungerInTotal() const noexcept {
+    return dead_in_total;
+}
+
+constexpr People SolverState::Arrived() const noexcept {
+    return kStartArrived;
+}
+
+constexpr Bushels SolverState::GrainFromAcre() const noexcept {
+    return kStartGrainFromAcre;
+}
+
+constexpr Bushels SolverState::GrainEatenByRats() const noexcept {
+    return kStartGrainEatenByRats;
+}
+
+constexpr bool SolverState::IsPlague() const noexcept {
+    return kStartIsPlague;
+}
+
+struct SolverInput final {
+    Acres area_to_buy;
+    Acres area_to_sell;
+    Bushels grain_to_feed;
+    Acres area_to_plant;
+};
+
+// turns action levels into amounts that pass AreaToBuy, AreaToSell, GrainToFeed, AreaToPlant and RoundInput
+constexpr SolverInput SolverConcreteInput(const SolverOptions &options, const SolverState &state,
+                                          const SolverAction action) noexcept {
+    const Acres trade_divisor = 2 * std::max<Acres>(1, options.trade_levels);
+    Acres area_to_buy = 0;
+    Acres area_to_sell = 0;
+    if (action.trade > 0) {
+        area_to_buy = state.grain / state.acre_price * static_cast<Acres>(action.trade) / trade_divisor;
+    } else if (action.trade < 0) {
+        area_to_sell = state.area * static_cast<Acres>(-action.trade) / trade_divisor;
+    }
+    const auto area = state.area + area_to_buy - area_to_sell;
+    const auto grain = state.grain - area_to_buy * state.acre_price + area_to_sell * state.acre_price;
+
+    auto feed_percent = kSolverMaxFeedPercent;
+    if (options.feed_levels > 1) {
+        const auto percent_span = kSolverMaxFeedPercent - kSolverMinFeedPercent;
+        feed_percent = kSolverMinFeedPercent + percent_span * action.feed / (options.feed_levels - 1);
+    }
+    const auto grain_needed = state.population * kGrainPerPerson * feed_percent / kSolverMaxFeedPercent;
+    const auto grain_to_feed = std::min({grain_needed, grain, state.grain});
+
+    const auto max_area_to_plant = std::min({
+        area,
+        state.area,
+        AreaCanPlantWithGrain(grain - grain_to_feed),
+        AreaCanPlantWithGrain(state.grain),
+        AreaCanPlantWithPopulation(state.population),
+    });
+    auto area_to_plant = max_area_to_plant;
+    if (options.plant_levels > 0) {
+        area_to_plant = max_area_to_plant * action.plant / options.plant_levels;
+    }
+    return {
+        .area_to_buy = area_to_buy,
+        .area_to_sell = area_to_sell,
+        .grain_to_feed = grain_to_feed,
+        .area_to_plant = area_to_plant,
+    };
+}
+
+constexpr std::uint64_t SolverBucketDown(const std::uint64_t value, const std::uint64_t step) noexcept {
+    return value / step;
+}
+
+constexpr std::uint64_t SolverBucketUp(const std::uint64_t value, const std::uint64_t step) noexcept {
+    return (value + step - 1) / step;
+}
+
+}
+
+inline Solver::Solver(const SolverOptions options)
+    : options_{options} {
+    options_.population_step = std::max<People>(1, options_.population_step);
+    options_.area_step = std::max<Acres>(1, options_.area_step);
+    options_.grain_step = std::max<Bushels>(1, options_.grain_step);
+    options_.record_policy = options_.record_policy && options_.max_cache_entries == 0;
+}
+
+constexpr const SolverOptions &Solver::Options() const noexcept {
+    return options_;
+}
+
+inline double Solver::Solve() {
+    return Value(detail::kFirstRound, detail::kStartPopulation, detail::kStartArea,
+                 detail::kStartGrain, detail::kStartDeadFromHunger);
+}
+
+inline double Solver::Value(const Round round, const People population, const Acres area,
+                            const Bushels grain, const People dead_in_total) {
+    return StateValue(Quantize(round, population, area, grain, dead_in_total));
+}
+
+inline SolverAction Solver::Decide(const Round round, const People population, const Acres area,
+                                   const Bushels grain, const Bushels acre_price, const People dead_in_total) {
+    const auto state = Quantize(round, population, area, grain, dead_in_total);
+    if (const auto found = policy_.find({.state = Pack(state), .acre_price = acre_price}); found != policy_.end()) {
+        return found->second;
+    }
+    return Best(state, acre_price).action;
+}
+
+template<GameState G>
+RoundInput Solver::Decide(const G &game) {
+    const detail::SolverState state{
+        .round = game.CurrentRound(),
+        .population = game.Population(),
+        .area = game.Area(),
+        .grain = game.Grain(),
+        .acre_price = game.AcrePrice(),
+        .dead_in_total = game.DeadFromHungerInTotal(),
+    };
+    const auto action = Decide(state.round, state.population, state.area, state.grain,
+                               state.acre_price, state.dead_in_total);
+    const auto input = detail::SolverConcreteInput(options_, state, action);
+    const auto area_to_buy = std::get<AreaToBuy>(AreaToBuy::New(input.area_to_buy, game));
+    const auto area_to_sell = std::get<AreaToSell>(AreaToSell::New(input.area_to_sell, game));
+    const auto grain_to_feed = std::get<GrainToFeed>(GrainToFeed::New(input.grain_to_feed, game));
+    const auto area_to_plant = std::get<AreaToPlant>(AreaToPlant::New(input.area_to_plant, game));
+    return std::get<RoundInput>(RoundInput::New(area_to_buy, area_to_sell, grain_to_feed, area_to_plant, game));
+}
+
+inline std::size_t Solver::CacheSize() const noexcept {
+    std::size_t size = 0;
+    for (std::size_t round = 0; round < values_.size(); ++round) {
+        size += values_[round].size() + values_without_trade_[round].size();
+    }
+    return size;
+}
+
+inline std::size_t Solver::PolicySize() const noexcept {
+    return policy_.size();
+}
+
+inline void Solver::InsertPolicy(std::ostream &ostream) const {
+    std::vector<std::pair<PolicyKey, SolverAction>> entries{policy_.begin(), policy_.end()};
+    std::sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        const auto order = [](const PolicyKey &key) {
+            return std::tuple{key.state >> 54, key.acre_price, key.state};
+        };
+        return order(lhs.first) < order(rhs.first);
+    });
+
+    const auto indent = detail::kInsertTagIndent;
+    const auto objective = options_.objective == Objective::ExpectedRank ? "expected_rank" : "survival";
+    ostream << "hamurabi_policy:\n"
+            << indent << "objective: " << objective << "\n"
+            << indent << "population_step: " << options_.population_step << "\n"
+            << indent << "area_step: " << options_.area_step << "\n"
+            << indent << "grain_step: " << options_.grain_step << "\n"
+            << indent << "trade_levels: " << +options_.trade_levels << "\n"
+            << indent << "feed_levels: " << +options_.feed_levels << "\n"
+            << indent << "plant_levels: " << +options_.plant_levels << "\n"
+            << indent << "# [round, population, area, grain, dead_in_total, acre_price, trade, feed, plant]\n"
+            << indent << "states:\n";
+    for (const auto &[key, action] : entries) {
+        const auto field = [state = key.state](const int shift, const int bits) {
+            return (state >> shift) & ((std::uint64_t{1} << bits) - 1);
+        };
+        ostream << indent << indent << "- ["
+                << field(54, 4) << ", "
+                << field(0, 16) * options_.population_step << ", "
+                << field(16, 16) * options_.area_step << ", "
+                << field(32, 20) * options_.grain_step << ", "
+                << detail::kSolverDeadInTotalBuckets[field(52, 2)] << ", "
+                << key.acre_price << ", "
+                << +action.trade << ", " << +action.feed << ", " << +action.plant << "]\n";
+    }
+}
+
+inline Solver::State Solver::Quantize(const Round round, const People population, const Acres area,
+                                      const Bushels grain, const People dead_in_total) const noexcept {
+    std::uint_fast8_t dead_bucket = 0;
+    if (options_.objective == Objective::ExpectedRank) {
+        while (dead_bucket + 1U < detail::kSolverDeadInTotalBuckets.size() &&
+            dead_in_total >= detail::kSolverDeadInTotalBuckets[dead_bucket + 1]) {
+            dead_bucket += 1;
+        }
+    }
+    // rounding against the player keeps the solver from planning on grain or land it does not have
+    return {
+        .round = round,
+        .population = static_cast<People>(detail::SolverBucketUp(population, options_.population_step)),
+        .area = static_cast<Acres>(detail::SolverBucketDown(area, options_.area_step)),
+        .grain = static_cast<Bushels>(detail::SolverBucketDown(grain, options_.grain_step)),
+        .dead_in_total = dead_bucket,
+    };
+}
+
+inline std::size_t Solver::PolicyKeyHash::operator()(const PolicyKey &key) const noexcept {
+    return std::hash<Key>{}(key.state ^ (static_cast<Key>(key.acre_price) * 0x9E3779B97F4A7C15));
+}
+
+// | round : 4 | dead in total : 2 | grain : 20 | area : 16 | population : 16 |, in buckets
+inline Solver::Key Solver::Pack(const State &state) noexcept {
+    const auto clamp = [](const std::uint64_t value, const int bits) {
+        return std::min(value, (std::uint64_t{1} << bits) - 1);
+    };
+    return clamp(state.population, 16) |
+        (clamp(state.area, 16) << 16) |
+        (clamp(state.grain, 20) << 32) |
+        (static_cast<Key>(state.dead_in_total) << 52) |
+        (clamp(state.round, 4) << 54);
+}
+
+inline double Solver::StateValue(const State &state) {
+    if (state.population == 0) {
+        return detail::kSolverGameOverValue;
+    }
+    const auto key = Pack(state);
+    auto &cache = values_[state.round];
+    if (const auto found = cache.find(key); found != cache.end()) {
+        return found->second.value;
+    }
+
+    // acre price is known before the decision, so the value averages the best decision over every price
+    double value = 0;
+    for (auto acre_price = detail::kMinAcrePrice; acre_price <= detail::kMaxAcrePrice; ++acre_price) {
+        value += Best(state, acre_price).value;
+    }
+    value /= static_cast<double>(detail::kMaxAcrePrice - detail::kMinAcrePrice + 1);
+    Remember(cache, state.round, key, {.value = value, .action = {}});
+    return value;
+}
+
+inline Solver::Decision Solver::Best(const State &state, const Bushels acre_price) {
+    auto best = BestWithoutTrade(state);
+    const auto trade_levels = static_cast<std::int_fast8_t>(options_.trade_levels);
+    for (std::int_fast8_t trade = -trade_levels; trade <= trade_levels; ++trade) {
+        if (trade == 0) {
+            continue;
+        }
+        const auto decision = BestForTrade(state, acre_price, trade);
+        if (decision.value > best.value) {
+            best = decision;
+        }
+    }
+    if (options_.record_policy) {
+        policy_.insert_or_assign(PolicyKey{.state = Pack(state), .acre_price = acre_price}, best.action);
+    }
+    return best;
+}
+
+// without trading the acre price never enters the round, so one answer serves every price
+inline Solver::Decision Solver::BestWithoutTrade(const State &state) {
+    const auto key = Pack(state);
+    auto &cache = values_without_trade_[state.round];
+    if (const auto found = cache.find(key); found != cache.end()) {
+        return found->second;
+    }
+    const auto decision = BestForTrade(state, detail::kMinAcrePrice, 0);
+    Remember(cache, state.round, key, decision);
+    return decision;
+}
+
+inline Solver::Decision Solver::BestForTrade(const State &state, const Bushels acre_price,
+                                             const std::int_fast8_t trade) {
+    Decision best{.value = -std::numeric_limits<double>::infinity(), .action = {.trade = trade, .feed = 0, .plant = 0}};
+    const auto feed_levels = std::max<std::uint_fast8_t>(1, options_.feed_levels);
+    for (std::uint_fast8_t feed = 0; feed < feed_levels; ++feed) {
+        for (std::uint_fast8_t plant = 0; plant <= options_.plant_levels; ++plant) {
+            const SolverAction action{.trade = trade, .feed = feed, .plant = plant};
+            const auto value = ActionValue(state, acre_price, action);
+            if (value > best.value) {
+                best = {.value = value, .action = action};
+            }
+        }
+    }
+    return best;
+}
+
+// expectation of the next state over harvest, rats and plague, following Game::PlayRound
+inline double Solver::ActionValue(const State &state, const Bushels acre_price, const SolverAction action) {
+    const detail::SolverState representative{
+        .round = state.round,
+        .population = state.population * options_.population_step,
+        .area = state.area * options_.area_step,
+        .grain = state.grain * options_.grain_step,
+        .acre_price = acre_price,
+        .dead_in_total = detail::kSolverDeadInTotalBuckets[state.dead_in_total],
+    };
+    const auto input = detail::SolverConcreteInput(options_, representative, action);
+    const auto area = representative.area + input.area_to_buy - input.area_to_sell;
+    const auto grain = representative.grain - input.area_to_buy * acre_price + input.area_to_sell * acre_price;
+
+    constexpr auto harvest_count = detail::kMaxGrainHarvestedFromAcre - detail::kMinGrainHarvestedFromAcre + 1;
+    constexpr auto rats_count = detail::kMaxGrainEatenByRatsFactor - detail::kMinGrainEatenByRatsFactor + 1;
+    constexpr auto plague_count = detail::kMaxPlaguePercent - detail::kMinPlaguePercent + 1;
+    constexpr auto plague_probability =
+        static_cast<double>(detail::kMaxPlagueCanOccurPercent - detail::kMinPlaguePercent + 1) / plague_count;
+
+    // many outcomes fall into the same bucket, so they are merged before looking the next state up
+    struct Outcome final {
+        State state;
+        double probability;
+    };
+    std::array<Outcome, harvest_count * rats_count * 2> outcomes{};
+    std::size_t outcome_count = 0;
+    double value = 0;
+
+    const auto feed_people_result = detail::FeedPeople(representative.population, input.grain_to_feed);
+    const auto dead = feed_people_result.dead;
+    const auto population = representative.population - dead;
+    const auto dead_in_total = representative.dead_in_total + dead;
+    if (detail::IsGameOver(dead, representative.population)) {
+        return detail::kSolverGameOverValue;
+    }
+
+    for (auto harvest = detail::kMinGrainHarvestedFromAcre; harvest <= detail::kMaxGrainHarvestedFromAcre; ++harvest) {
+        const auto grain_after_harvest = grain + input.area_to_plant * harvest -
+            detail::GrainToPlantArea(input.area_to_plant) + feed_people_result.grain_left - input.grain_to_feed;
+        for (auto rats = detail::kMinGrainEatenByRatsFactor; rats <= detail::kMaxGrainEatenByRatsFactor; ++rats) {
+            const auto grain_eaten_by_rats = (grain_after_harvest * rats) / detail::kGrainEatenByRatsDivisor;
+            const auto grain_left = grain_after_harvest - grain_eaten_by_rats;
+            const auto arrived = detail::CountArrivedPeople(dead, harvest, grain_left);
+            for (const bool is_plague : {false, true}) {
+                const auto next_population = is_plague ? (population + arrived) / 2 : population + arrived;
+                const auto probability = (is_plague ? plague_probability : 1 - plague_probability) /
+                    static_cast<double>(harvest_count * rats_count);
+                if (state.round + 1 > detail::kLastRound) {
+                    value += probability * TerminalValue(next_population, area, dead_in_total);
+                    continue;
+                }
+                const auto next = Quantize(state.round + 1, next_population, area, grain_left, dead_in_total);
+                const auto same = std::find_if(outcomes.begin(), outcomes.begin() + outcome_count,
+                                               [&next](const Outcome &outcome) {
+                                                   return outcome.state.population == next.population &&
+                                                       outcome.state.area == next.area &&
+                                                       outcome.state.grain == next.grain &&
+                                                       outcome.state.dead_in_total == next.dead_in_total;
+                                               });
+                if (same != outcomes.begin() + outcome_count) {
+                    same->probability += probability;
+                } else {
+                    outcomes[outcome_count++] = {.state = next, .probability = probability};
+                }
+            }
+        }
+    }
+    for (std::size_t index = 0; index < outcome_count; ++index) {
+        value += outcomes[index].probability * StateValue(outcomes[index].state);
+    }
+    return value;
+}
+
+inline double Solver::TerminalValue(const People population, const Acres area,
+                                    const People dead_in_total) const noexcept {
+    if (population == 0) {
+        return detail::kSolverGameOverValue;
+    }
+    switch (options_.objective) {
+        case Objective::Survival: {
+            return detail::kSolverSurvivedValue;
+        }
+        case Objective::ExpectedRank: {
+            const detail::SolverState state{
+                .round = detail::kLastRound + 1,
+                .population = population,
+                .area = area,
+                .grain = 0,
+                .acre_price = 0,
+                .dead_in_total = dead_in_total,
+            };
+            return static_cast<double>(Statistics{state}.Rank());
+        }
+    }
+    return detail::kSolverGameOverValue;
+}
+
+inline void Solver::Remember(Cache &cache, const Round round, const Key key, const Decision decision) {
+    if (options_.max_cache_entries != 0 && CacheSize() >= options_.max_cache_entries) {
+        // later rounds are the cheapest to recompute, so they are dropped first
+        for (auto later = values_.size() - 1; later > round; --later) {
+            values_[later].clear();
+            values_without_trade_[later].clear();
+            if (CacheSize() < options_.max_cache_entries) {
+                break;
+            }
+        }
+        if (CacheSize() >= options_.max_cache_entries) {
+            return;
+        }
+    }
+    cache.emplace(key, decision);
+}
+
+inline SolverPolicy::SolverPolicy(Solver &solver) noexcept
+    : solver_{&solver} {}
+
+template<GameState G>
+RoundInput SolverPolicy::operator()(const G &game) const {
+    return solver_->Decide(game);
+}
+
+}
+
+#endif //HAMURABI_SOLVER_INL
@@ -2,7 +2,8 @@
 #define HAMURABI_STATISTICS
 
 #include "Resources.hpp"
-#include "Game.fwd"
+#include "GameState.hpp"
+#include "Rules.hpp"
 
 namespace hamurabi {
 
@@ -12,8 +13,8 @@ enum class Rank : std::uint8_t {
 
 class Statistics final {
   public:
-    template<class T>
-    constexpr explicit Statistics(const Game<T> &game) noexcept;
+    template<GameState G>
+    constexpr explicit Statistics(const G &game) noexcept;
 
     [[nodiscard]]
     constexpr People AverageDeadFromHungerPercent() const noexcept;
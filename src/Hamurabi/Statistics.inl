@@ -3,9 +3,9 @@
 
 namespace hamurabi {
 
-template<class T>
-constexpr Statistics::Statistics(const Game<T> &game) noexcept
-    : average_dead_from_hunger_percent_{game.DeadFromHungerInTotal() / detail::kLastRound},
+template<GameState G>
+constexpr Statistics::Statistics(const G &game) noexcept
+    : average_dead_from_hunger_percent_{game.DeadFromHungerInTotal() / detail::RulesOf(game).LastRound()},
       dead_from_hunger_{game.DeadFromHungerInTotal()},
       area_by_person_{game.Area() / game.Population()} {}
 
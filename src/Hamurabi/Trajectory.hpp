@@ -0,0 +1,129 @@
+#ifndef HAMURABI_TRAJECTORY
+#define HAMURABI_TRAJECTORY
+
+#include <array>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <string_view>
+
+#include "Game.hpp"
+#include "ReplayLog.hpp"
+
+namespace hamurabi {
+
+// one row per state a game passes through, the start state included
+enum class TrajectoryColumn : std::uint8_t {
+    Game,
+    Round,
+    Population,
+    Area,
+    Grain,
+    AcrePrice,
+    DeadFromHunger,
+    DeadFromHungerInTotal,
+    Arrived,
+    GrainFromAcre,
+    GrainEatenByRats,
+    IsPlague,
+};
+
+extern const std::size_t kTrajectoryColumnCount;
+
+[[nodiscard]]
+static inline constexpr std::string_view TrajectoryColumnName(TrajectoryColumn column) noexcept;
+
+namespace serialization {
+
+enum class ColumnEncoding : std::uint8_t {
+    // every value as a varint
+    Varint,
+    // (run length, value) pairs
+    RunLength,
+    // distinct values in order of appearance, then (run length, index) pairs
+    Dictionary,
+};
+
+// small domains are dictionary encoded, the game id repeats for the whole game
+[[nodiscard]]
+static inline constexpr ColumnEncoding TrajectoryColumnEncoding(TrajectoryColumn column) noexcept;
+
+// rows kept column by column, encoded into a batch that decodes on its own
+class TrajectoryBatch final {
+  public:
+    [[nodiscard]]
+    std::size_t Size() const noexcept;
+
+    [[nodiscard]]
+    std::span<const std::uint64_t> Column(TrajectoryColumn column) const noexcept;
+
+    template<class T, class I, class R>
+    void Append(std::uint64_t game_id, const Game<T, I, R> &game);
+
+    void Clear() noexcept;
+
+    // the framed batch, valid until the batch changes
+    [[nodiscard]]
+    std::span<const std::byte> Encode();
+
+    // replaces the rows with the ones of a batch payload
+    [[nodiscard]]
+    ExtractResult Decode(std::span<const std::byte> payload);
+
+  private:
+    std::array<std::vector<std::uint64_t>, static_cast<std::size_t>(TrajectoryColumn::IsPlague) + 1> columns_;
+    std::vector<std::byte> bytes_;
+    std::vector<std::byte> column_bytes_;
+};
+
+// header with the columns and their encodings, then batches as they fill up, then an empty batch,
+// so memory stays at one batch however many games are written, a batch holds at most 2^20 rows
+class TrajectoryWriter final {
+  public:
+    explicit TrajectoryWriter(std::ostream &ostream, std::size_t rows_per_batch = 1 << 16);
+
+    TrajectoryWriter(const TrajectoryWriter &) = delete;
+    TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+    template<class T, class I, class R>
+    void Append(std::uint64_t game_id, const Game<T, I, R> &game);
+
+    [[nodiscard]]
+    InsertResult Close();
+
+  private:
+    void Flush();
+
+    std::ostream *ostream_;
+    std::size_t rows_per_batch_;
+    TrajectoryBatch batch_;
+};
+
+class TrajectoryReader final {
+  public:
+    [[nodiscard]]
+    static std::optional<TrajectoryReader> Open(std::istream &istream);
+
+    // an empty batch after success is the end of the stream
+    [[nodiscard]]
+    ExtractResult Extract(TrajectoryBatch &batch);
+
+  private:
+    explicit TrajectoryReader(std::istream &istream) noexcept;
+
+    std::istream *istream_;
+    std::vector<std::byte> payload_;
+};
+
+static inline void InsertTrajectoryHeader(std::vector<std::byte> &bytes);
+
+static inline void InsertTrajectoryEnd(std::vector<std::byte> &bytes);
+
+}
+
+}
+
+#include "Trajectory.inl"
+
+#endif //HAMURABI_TRAJECTORY
@@ -0,0 +1,364 @@
+#ifndef HAMURABI_TRAJECTORY_INL
+#define HAMURABI_TRAJECTORY_INL
+
+#include <iterator>
+#include <algorithm>
+
+namespace hamurabi {
+
+inline constexpr std::size_t kTrajectoryColumnCount = static_cast<std::size_t>(TrajectoryColumn::IsPlague) + 1;
+
+constexpr std::string_view TrajectoryColumnName(const TrajectoryColumn column) noexcept {
+    switch (column) {
+        case TrajectoryColumn::Game: {
+            return "game";
+        }
+        case TrajectoryColumn::Round: {
+            return "round";
+        }
+        case TrajectoryColumn::Population: {
+            return "population";
+        }
+        case TrajectoryColumn::Area: {
+            return "area";
+        }
+        case TrajectoryColumn::Grain: {
+            return "grain";
+        }
+        case TrajectoryColumn::AcrePrice: {
+            return "acre_price";
+        }
+        case TrajectoryColumn::DeadFromHunger: {
+            return "dead_from_hunger";
+        }
+        case TrajectoryColumn::DeadFromHungerInTotal: {
+            return "dead_from_hunger_in_total";
+        }
+        case TrajectoryColumn::Arrived: {
+            return "arrived";
+        }
+        case TrajectoryColumn::GrainFromAcre: {
+            return "grain_from_acre";
+        }
+        case TrajectoryColumn::GrainEatenByRats: {
+            return "grain_eaten_by_rats";
+        }
+        case TrajectoryColumn::IsPlague: {
+            return "is_plague";
+        }
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+inline constexpr std::array<std::byte, 4> kTrajectoryMagic = {std::byte{'H'}, std::byte{'M'}, std::byte{'R'}, std::byte{'T'}};
+inline constexpr std::uint16_t kTrajectoryVersion = 1;
+
+// the batch size in front of every batch
+inline constexpr std::size_t kTrajectoryFrameSize = 8;
+
+// a dictionary column with more distinct values than this in a batch falls back to varints
+inline constexpr std::size_t kTrajectoryDictionaryLimit = 256;
+
+// rows a writer puts in a batch at most, whatever it is asked for
+inline constexpr std::size_t kTrajectoryMaxBatchRows = std::size_t{1} << 20;
+
+// the largest batch a writer can make, a varint is at most ten bytes and a row at most two of them in a column,
+// so a frame above it is corrupt and is not allocated
+inline constexpr std::uint64_t kTrajectoryMaxPayloadSize =
+    10 + (kTrajectoryColumnCount * (1 + 10 + (10 * (kTrajectoryDictionaryLimit + 1)) + (20 * kTrajectoryMaxBatchRows)));
+
+template<class F>
+constexpr void ForEachRun(const std::span<const std::uint64_t> values, F on_run) {
+    std::size_t first = 0;
+    while (first < values.size()) {
+        auto last = first + 1;
+        while (last < values.size() && values[last] == values[first]) {
+            ++last;
+        }
+        on_run(static_cast<std::uint64_t>(last - first), values[first]);
+        first = last;
+    }
+}
+
+inline void InsertVarintColumn(std::vector<std::byte> &bytes, const std::span<const std::uint64_t> values) {
+    for (const auto value : values) {
+        InsertVarint(bytes, value);
+    }
+}
+
+inline void InsertRunLengthColumn(std::vector<std::byte> &bytes, const std::span<const std::uint64_t> values) {
+    ForEachRun(values, [&](const std::uint64_t length, const std::uint64_t value) {
+        InsertVarint(bytes, length);
+        InsertVarint(bytes, value);
+    });
+}
+
+[[nodiscard]]
+inline bool InsertDictionaryColumn(std::vector<std::byte> &bytes, const std::span<const std::uint64_t> values) {
+    std::vector<std::uint64_t> dictionary;
+    for (const auto value : values) {
+        if (std::find(dictionary.begin(), dictionary.end(), value) != dictionary.end()) {
+            continue;
+        }
+        if (dictionary.size() == kTrajectoryDictionaryLimit) {
+            return false;
+        }
+        dictionary.push_back(value);
+    }
+
+    InsertVarint(bytes, dictionary.size());
+    InsertVarintColumn(bytes, dictionary);
+    ForEachRun(values, [&](const std::uint64_t length, const std::uint64_t value) {
+        const auto index = std::find(dictionary.begin(), dictionary.end(), value) - dictionary.begin();
+        InsertVarint(bytes, length);
+        InsertVarint(bytes, static_cast<std::uint64_t>(index));
+    });
+    return true;
+}
+
+// the column must fill exactly the rows and use up exactly its bytes
+[[nodiscard]]
+inline bool ExtractColumn(const std::span<const std::byte> bytes, const ser::ColumnEncoding encoding,
+                          const std::size_t rows, std::vector<std::uint64_t> &values) {
+    values.clear();
+    std::size_t offset = 0;
+    std::vector<std::uint64_t> dictionary;
+    if (encoding == ser::ColumnEncoding::Dictionary) {
+        const auto size = ExtractVarint(bytes, offset);
+        if (!size || *size > kTrajectoryDictionaryLimit) {
+            return false;
+        }
+        for (std::uint64_t index = 0; index < *size; ++index) {
+            const auto value = ExtractVarint(bytes, offset);
+            if (!value) {
+                return false;
+            }
+            dictionary.push_back(*value);
+        }
+    }
+
+    while (values.size() < rows) {
+        const auto first = ExtractVarint(bytes, offset);
+        if (!first) {
+            return false;
+        }
+        if (encoding == ser::ColumnEncoding::Varint) {
+            values.push_back(*first);
+            continue;
+        }
+        const auto value = ExtractVarint(bytes, offset);
+        if (!value || *first == 0 || *first > rows - values.size()) {
+            return false;
+        }
+        if (encoding == ser::ColumnEncoding::Dictionary && *value >= dictionary.size()) {
+            return false;
+        }
+        const auto run_value = encoding == ser::ColumnEncoding::Dictionary ? dictionary[*value] : *value;
+        values.insert(values.end(), static_cast<std::size_t>(*first), run_value);
+    }
+    return offset == bytes.size();
+}
+
+}
+
+namespace serialization {
+
+constexpr ColumnEncoding TrajectoryColumnEncoding(const TrajectoryColumn column) noexcept {
+    switch (column) {
+        case TrajectoryColumn::Game: {
+            return ColumnEncoding::RunLength;
+        }
+        case TrajectoryColumn::AcrePrice:
+        case TrajectoryColumn::GrainFromAcre:
+        case TrajectoryColumn::IsPlague: {
+            return ColumnEncoding::Dictionary;
+        }
+        default: {
+            return ColumnEncoding::Varint;
+        }
+    }
+}
+
+inline std::size_t TrajectoryBatch::Size() const noexcept {
+    return columns_.front().size();
+}
+
+inline std::span<const std::uint64_t> TrajectoryBatch::Column(const TrajectoryColumn column) const noexcept {
+    return columns_[static_cast<std::size_t>(column)];
+}
+
+template<class T, class I, class R>
+void TrajectoryBatch::Append(const std::uint64_t game_id, const Game<T, I, R> &game) {
+    const std::array<std::uint64_t, kTrajectoryColumnCount> row = {
+        game_id,
+        game.CurrentRound(),
+        game.Population(),
+        game.Area(),
+        game.Grain(),
+        game.AcrePrice(),
+        game.DeadFromHunger(),
+        game.DeadFromHungerInTotal(),
+        game.Arrived(),
+        game.GrainFromAcre(),
+        game.GrainEatenByRats(),
+        game.IsPlague(),
+    };
+    for (std::size_t column = 0; column < kTrajectoryColumnCount; ++column) {
+        columns_[column].push_back(row[column]);
+    }
+}
+
+inline void TrajectoryBatch::Clear() noexcept {
+    for (auto &column : columns_) {
+        column.clear();
+    }
+}
+
+inline std::span<const std::byte> TrajectoryBatch::Encode() {
+    bytes_.assign(detail::kTrajectoryFrameSize, std::byte{0});
+    detail::InsertVarint(bytes_, Size());
+    for (std::size_t column = 0; column < kTrajectoryColumnCount; ++column) {
+        const std::span<const std::uint64_t> values = columns_[column];
+        auto encoding = TrajectoryColumnEncoding(static_cast<TrajectoryColumn>(column));
+        column_bytes_.clear();
+        if (encoding == ColumnEncoding::Dictionary && !detail::InsertDictionaryColumn(column_bytes_, values)) {
+            encoding = ColumnEncoding::Varint;
+            column_bytes_.clear();
+        }
+        if (encoding == ColumnEncoding::RunLength) {
+            detail::InsertRunLengthColumn(column_bytes_, values);
+        } else if (encoding == ColumnEncoding::Varint) {
+            detail::InsertVarintColumn(column_bytes_, values);
+        }
+        bytes_.push_back(static_cast<std::byte>(encoding));
+        detail::InsertVarint(bytes_, column_bytes_.size());
+        bytes_.insert(bytes_.end(), column_bytes_.begin(), column_bytes_.end());
+    }
+    detail::StoreLittleEndian(std::span{bytes_}.first(detail::kTrajectoryFrameSize),
+                              bytes_.size() - detail::kTrajectoryFrameSize);
+    return bytes_;
+}
+
+inline ExtractResult TrajectoryBatch::Decode(const std::span<const std::byte> payload) {
+    Clear();
+    std::size_t offset = 0;
+    const auto rows = detail::ExtractVarint(payload, offset);
+    // every row takes at least a byte in a varint column, which bounds what a corrupt count may allocate
+    if (!rows || *rows > payload.size()) {
+        return ExtractResult::Error;
+    }
+    for (auto &column : columns_) {
+        if (offset >= payload.size()) {
+            return ExtractResult::Error;
+        }
+        const auto encoding = static_cast<ColumnEncoding>(payload[offset++]);
+        const auto size = detail::ExtractVarint(payload, offset);
+        if (encoding > ColumnEncoding::Dictionary || !size || *size > payload.size() - offset) {
+            Clear();
+            return ExtractResult::Error;
+        }
+        if (!detail::ExtractColumn(payload.subspan(offset, *size), encoding, *rows, column)) {
+            Clear();
+            return ExtractResult::Error;
+        }
+        offset += *size;
+    }
+    return offset == payload.size() ? ExtractResult::Success : ExtractResult::Error;
+}
+
+inline TrajectoryWriter::TrajectoryWriter(std::ostream &ostream, const std::size_t rows_per_batch)
+    : ostream_{&ostream},
+      rows_per_batch_{std::clamp<std::size_t>(rows_per_batch, 1, detail::kTrajectoryMaxBatchRows)} {
+    std::vector<std::byte> header;
+    InsertTrajectoryHeader(header);
+    ostream_->write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+}
+
+template<class T, class I, class R>
+void TrajectoryWriter::Append(const std::uint64_t game_id, const Game<T, I, R> &game) {
+    batch_.Append(game_id, game);
+    if (batch_.Size() >= rows_per_batch_) {
+        Flush();
+    }
+}
+
+inline InsertResult TrajectoryWriter::Close() {
+    if (batch_.Size() != 0) {
+        Flush();
+    }
+    std::vector<std::byte> end;
+    InsertTrajectoryEnd(end);
+    ostream_->write(reinterpret_cast<const char *>(end.data()), static_cast<std::streamsize>(end.size()));
+    ostream_->flush();
+    return *ostream_ ? InsertResult::Success : InsertResult::Error;
+}
+
+inline void TrajectoryWriter::Flush() {
+    const auto bytes = batch_.Encode();
+    ostream_->write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    batch_.Clear();
+}
+
+inline TrajectoryReader::TrajectoryReader(std::istream &istream) noexcept
+    : istream_{&istream} {}
+
+inline std::optional<TrajectoryReader> TrajectoryReader::Open(std::istream &istream) {
+    std::vector<std::byte> expected;
+    InsertTrajectoryHeader(expected);
+    std::vector<std::byte> header(expected.size());
+    istream.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    if (!istream || header != expected) {
+        return std::nullopt;
+    }
+    return TrajectoryReader{istream};
+}
+
+inline ExtractResult TrajectoryReader::Extract(TrajectoryBatch &batch) {
+    std::array<std::byte, detail::kTrajectoryFrameSize> frame{};
+    istream_->read(reinterpret_cast<char *>(frame.data()), frame.size());
+    if (!*istream_) {
+        return ExtractResult::Error;
+    }
+    const auto size = detail::LoadLittleEndian(frame);
+    if (size == 0) {
+        batch.Clear();
+        return ExtractResult::Success;
+    }
+    if (size > detail::kTrajectoryMaxPayloadSize) {
+        return ExtractResult::Error;
+    }
+    payload_.resize(static_cast<std::size_t>(size));
+    istream_->read(reinterpret_cast<char *>(payload_.data()), static_cast<std::streamsize>(payload_.size()));
+    if (!*istream_) {
+        return ExtractResult::Error;
+    }
+    return batch.Decode(payload_);
+}
+
+void InsertTrajectoryHeader(std::vector<std::byte> &bytes) {
+    bytes.insert(bytes.end(), detail::kTrajectoryMagic.begin(), detail::kTrajectoryMagic.end());
+    bytes.resize(bytes.size() + 2);
+    detail::StoreLittleEndian(std::span{bytes}.last(2), detail::kTrajectoryVersion);
+    detail::InsertVarint(bytes, kTrajectoryColumnCount);
+    for (std::size_t column = 0; column < kTrajectoryColumnCount; ++column) {
+        const auto name = TrajectoryColumnName(static_cast<TrajectoryColumn>(column));
+        bytes.push_back(static_cast<std::byte>(TrajectoryColumnEncoding(static_cast<TrajectoryColumn>(column))));
+        detail::InsertVarint(bytes, name.size());
+        std::transform(name.begin(), name.end(), std::back_inserter(bytes), [](const char letter) {
+            return static_cast<std::byte>(letter);
+        });
+    }
+}
+
+void InsertTrajectoryEnd(std::vector<std::byte> &bytes) {
+    bytes.resize(bytes.size() + detail::kTrajectoryFrameSize);
+    detail::StoreLittleEndian(std::span{bytes}.last(detail::kTrajectoryFrameSize), 0);
+}
+
+}
+
+}
+
+#endif //HAMURABI_TRAJECTORY_INL
@@ -0,0 +1,80 @@
+#ifndef PLAY_AUTOSAVE
+#define PLAY_AUTOSAVE
+
+#include <mutex>
+#include <thread>
+#include <optional>
+#include <filesystem>
+#include <condition_variable>
+
+#include "Detail.hpp"
+
+namespace play {
+
+enum class Durability : std::uint8_t {
+    EveryRound,
+    EveryNRounds,
+    OnExit,
+};
+
+struct AutosaveOptions final {
+    Durability durability = Durability::EveryRound;
+    hamurabi::Round every_n_rounds = 1;
+    std::filesystem::path path = detail::kSaveFileName;
+};
+
+// writes snapshots on its own thread, a snapshot which was not written yet is replaced by a newer one
+class Autosave final {
+  public:
+    Autosave(Autosave &&other) = delete;
+    Autosave &operator=(Autosave &&other) = delete;
+
+    Autosave(const Autosave &) = delete;
+    Autosave &operator=(const Autosave &) = delete;
+
+    explicit Autosave(AutosaveOptions options);
+
+    ~Autosave();
+
+    [[nodiscard]]
+    constexpr const AutosaveOptions &Options() const noexcept;
+
+    template<class T>
+    void Save(const hamurabi::Game<T> &game);
+
+    template<class T>
+    void SaveOnExit(const hamurabi::Game<T> &game);
+
+    void Flush();
+
+    [[nodiscard]]
+    bool IsLastSaveFailed() const;
+
+  private:
+    template<class T>
+    void Push(const hamurabi::Game<T> &game);
+
+    void Work();
+
+    AutosaveOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::optional<std::string> pending_;
+    bool is_writing_;
+    bool is_stopping_;
+    bool is_last_save_failed_;
+    std::thread worker_;
+};
+
+namespace detail {
+
+[[nodiscard]]
+static inline bool WriteFileAtomically(const std::filesystem::path &path, std::string_view contents);
+
+}
+
+}
+
+#include "Autosave.inl"
+
+#endif //PLAY_AUTOSAVE
@@ -0,0 +1,148 @@
+#ifndef PLAY_AUTOSAVE_INL
+#define PLAY_AUTOSAVE_INL
+
+#include <cerrno>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace play {
+
+inline Autosave::Autosave(AutosaveOptions options)
+    : options_{std::move(options)},
+      is_writing_{false},
+      is_stopping_{false},
+      is_last_save_failed_{false},
+      worker_{[this] { Work(); }} {}
+
+inline Autosave::~Autosave() {
+    {
+        const std::lock_guard lock{mutex_};
+        is_stopping_ = true;
+    }
+    condition_.notify_all();
+    worker_.join();
+}
+
+constexpr const AutosaveOptions &Autosave::Options() const noexcept {
+    return options_;
+}
+
+template<class T>
+void Autosave::Save(const hamurabi::Game<T> &game) {
+    switch (options_.durability) {
+        case Durability::EveryRound: {
+            Push(game);
+            break;
+        }
+        case Durability::EveryNRounds: {
+            const auto every_n_rounds = std::max<hamurabi::Round>(1, options_.every_n_rounds);
+            if ((game.CurrentRound() - hamurabi::detail::kFirstRound) % every_n_rounds == 0) {
+                Push(game);
+            }
+            break;
+        }
+        case Durability::OnExit: {
+            break;
+        }
+    }
+}
+
+template<class T>
+void Autosave::SaveOnExit(const hamurabi::Game<T> &game) {
+    Push(game);
+    Flush();
+}
+
+inline void Autosave::Flush() {
+    std::unique_lock lock{mutex_};
+    condition_.wait(lock, [this] { return !pending_.has_value() && !is_writing_; });
+}
+
+inline bool Autosave::IsLastSaveFailed() const {
+    const std::lock_guard lock{mutex_};
+    return is_last_save_failed_;
+}
+
+// the game is serialized on the caller thread, so the worker never touches the game itself
+template<class T>
+void Autosave::Push(const hamurabi::Game<T> &game) {
+    std::ostringstream snapshot;
+    hamurabi::ser::InsertGame(snapshot, game, hamurabi::ser::Format::YAML);
+    {
+        const std::lock_guard lock{mutex_};
+        pending_ = std::move(snapshot).str();
+    }
+    condition_.notify_all();
+}
+
+inline void Autosave::Work() {
+    std::unique_lock lock{mutex_};
+    while (true) {
+        condition_.wait(lock, [this] { return pending_.has_value() || is_stopping_; });
+        if (!pending_.has_value()) {
+            return;
+        }
+        const auto contents = std::move(pending_).value();
+        pending_.reset();
+        is_writing_ = true;
+
+        lock.unlock();
+        const auto is_written = detail::WriteFileAtomically(options_.path, contents);
+        lock.lock();
+
+        is_writing_ = false;
+        is_last_save_failed_ = !is_written;
+        condition_.notify_all();
+    }
+}
+
+namespace detail {
+
+// readers see either the old save or the new one, never a truncated file
+bool WriteFileAtomically(const std::filesystem::path &path, std::string_view contents) {
+    auto temporary_path = path;
+    temporary_path += ".tmp";
+
+    const auto descriptor = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) {
+        return false;
+    }
+    while (!contents.empty()) {
+        const auto written = ::write(descriptor, contents.data(), contents.size());
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0) {
+            ::close(descriptor);
+            return false;
+        }
+        contents.remove_prefix(static_cast<std::size_t>(written));
+    }
+    if (::fsync(descriptor) != 0 || ::close(descriptor) != 0) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        return false;
+    }
+
+    // the rename itself is durable only after the directory is synced
+    const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."};
+    const auto directory_descriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directory_descriptor < 0) {
+        return false;
+    }
+    const auto is_synced = ::fsync(directory_descriptor) == 0;
+    ::close(directory_descriptor);
+    return is_synced;
+}
+
+}
+
+}
+
+#endif //PLAY_AUTOSAVE_INL
@@ -2,29 +2,32 @@
 #define PLAY_DETAIL
 
 #include "../Hamurabi/Game.hpp"
+#include "OutputSink.hpp"
+#include "InputMode.hpp"
+#include "LineChannel.hpp"
 
 #include <fstream>
 
 namespace play::detail {
 
-static inline void InsertGreetings(std::ostream &ostream);
+static inline void InsertGreetings(OutputSink &sink);
 
-static inline void InsertNotEnoughArea(std::ostream &ostream, hamurabi::NotEnoughArea error);
+static inline void InsertNotEnoughArea(OutputSink &sink, hamurabi::NotEnoughArea error);
 
-static inline void InsertNotEnoughGrain(std::ostream &ostream, hamurabi::NotEnoughGrain error);
+static inline void InsertNotEnoughGrain(OutputSink &sink, hamurabi::NotEnoughGrain error);
 
-static inline void InsertNotEnoughPeople(std::ostream &ostream, hamurabi::NotEnoughPeople error);
+static inline void InsertNotEnoughPeople(OutputSink &sink, hamurabi::NotEnoughPeople error);
 
-static inline void InsertGameOver(std::ostream &ostream, hamurabi::GameOver game_over);
+static inline void InsertGameOver(OutputSink &sink, hamurabi::GameOver game_over);
 
 template<class T>
-static inline void InsertGameState(std::ostream &ostream, const hamurabi::Game<T> &game);
+static inline void InsertGameState(OutputSink &sink, const hamurabi::Game<T> &game);
 
-static inline void InsertGameStatistics(std::ostream &ostream, hamurabi::Statistics statistics);
+static inline void InsertGameStatistics(OutputSink &sink, hamurabi::Statistics statistics);
 
-static inline void InsertGoodbye(std::ostream &ostream);
+static inline void InsertGoodbye(OutputSink &sink);
 
-static inline void InsertOldGameFound(std::ostream &ostream);
+static inline void InsertOldGameFound(OutputSink &sink);
 
 extern const hamurabi::string_literal kExitCommand;
 
@@ -35,44 +38,120 @@ struct Exit final {};
 template<class T>
 using ExitOr = std::variant<Exit, T>;
 
+extern const hamurabi::string_literal kCannotDoMessage;
+
+template<std::unsigned_integral T>
+[[nodiscard]]
+static inline std::optional<ExitOr<T>> ParseUnsigned(std::string_view line);
+
 template<std::unsigned_integral T>
 [[nodiscard]]
-static inline ExitOr<T> ExtractUnsigned(std::istream &istream, std::ostream &ostream,
+static inline Task<ExitOr<T>> AwaitUnsigned(LineChannel &channel, std::string_view message);
+
+// runs the task to its end on lines of the stream, the blocking face of the prompt tasks
+template<class R>
+[[nodiscard]]
+static inline R ExtractLines(Task<R> task, LineChannel &channel, std::istream &istream, OutputSink &sink);
+
+template<std::unsigned_integral T>
+[[nodiscard]]
+static inline ExitOr<T> ExtractUnsigned(std::istream &istream, OutputSink &sink,
                                         std::string_view message);
 
+extern const hamurabi::string_literal kAreaToBuyMessage;
+extern const hamurabi::string_literal kAreaToSellMessage;
+extern const hamurabi::string_literal kGrainToFeedMessage;
+extern const hamurabi::string_literal kAreaToPlantMessage;
+
+template<class T>
+[[nodiscard]]
+static inline Task<ExitOr<hamurabi::AreaToBuy>> AwaitAreaToBuy(LineChannel &channel, const hamurabi::Game<T> &game);
+
+template<class T>
+[[nodiscard]]
+static inline Task<ExitOr<hamurabi::AreaToSell>> AwaitAreaToSell(LineChannel &channel,
+                                                                 const hamurabi::Game<T> &game);
+
+template<class T>
+[[nodiscard]]
+static inline Task<ExitOr<hamurabi::GrainToFeed>> AwaitGrainToFeed(LineChannel &channel,
+                                                                   const hamurabi::Game<T> &game);
+
+template<class T>
+[[nodiscard]]
+static inline Task<ExitOr<hamurabi::AreaToPlant>> AwaitAreaToPlant(LineChannel &channel,
+                                                                   const hamurabi::Game<T> &game);
+
 template<class T>
 [[nodiscard]]
-static inline ExitOr<hamurabi::AreaToBuy> ExtractAreaToBuy(std::istream &istream, std::ostream &ostream,
+static inline Task<ExitOr<hamurabi::RoundInput>> AwaitRoundInput(LineChannel &channel,
+                                                                 const hamurabi::Game<T> &game);
+
+struct RoundLine final {
+    hamurabi::Acres area_to_buy;
+    hamurabi::Acres area_to_sell;
+    hamurabi::Bushels grain_to_feed;
+    hamurabi::Acres area_to_plant;
+};
+
+[[nodiscard]]
+static inline std::optional<ExitOr<RoundLine>> ParseRoundLine(std::string_view line) noexcept;
+
+extern const hamurabi::string_literal kRoundInputMessage;
+
+static inline void InsertRejected(OutputSink &sink, std::string_view component);
+
+// with the error of the result, the visitor is built here so that it never lives in a coroutine frame
+template<class V>
+static inline void InsertRejected(OutputSink &sink, std::string_view component, const V &result);
+
+// the same checks as AwaitRoundInput, but a whole round per line and a single report naming what failed
+template<class T>
+[[nodiscard]]
+static inline Task<ExitOr<hamurabi::RoundInput>> AwaitCompactRoundInput(LineChannel &channel,
+                                                                        const hamurabi::Game<T> &game);
+
+// the whole game from greetings to goodbye, the game lives in the coroutine frame
+template<class T>
+[[nodiscard]]
+static inline Task<std::optional<hamurabi::Statistics>> AwaitGame(LineChannel &channel, hamurabi::Game<T> game,
+                                                                   InputMode input_mode);
+
+template<class T>
+[[nodiscard]]
+static inline ExitOr<hamurabi::AreaToBuy> ExtractAreaToBuy(std::istream &istream, OutputSink &sink,
                                                            const hamurabi::Game<T> &game);
 
 template<class T>
 [[nodiscard]]
-static inline ExitOr<hamurabi::AreaToSell> ExtractAreaToSell(std::istream &istream, std::ostream &ostream,
+static inline ExitOr<hamurabi::AreaToSell> ExtractAreaToSell(std::istream &istream, OutputSink &sink,
                                                              const hamurabi::Game<T> &game);
 
 template<class T>
 [[nodiscard]]
-static inline ExitOr<hamurabi::GrainToFeed> ExtractGrainToFeed(std::istream &istream, std::ostream &ostream,
+static inline ExitOr<hamurabi::GrainToFeed> ExtractGrainToFeed(std::istream &istream, OutputSink &sink,
                                                                const hamurabi::Game<T> &game);
 
 template<class T>
 [[nodiscard]]
-static inline ExitOr<hamurabi::AreaToPlant> ExtractAreaToPlant(std::istream &istream, std::ostream &ostream,
+static inline ExitOr<hamurabi::AreaToPlant> ExtractAreaToPlant(std::istream &istream, OutputSink &sink,
                                                                const hamurabi::Game<T> &game);
 
 template<class T>
 [[nodiscard]]
-static inline ExitOr<hamurabi::RoundInput> ExtractRoundInput(std::istream &istream, std::ostream &ostream,
+static inline ExitOr<hamurabi::RoundInput> ExtractRoundInput(std::istream &istream, OutputSink &sink,
                                                              const hamurabi::Game<T> &game);
 
-extern const hamurabi::string_literal kSaveFileName;
-
 template<class T>
-static inline void InsertGame(std::fstream &file, const hamurabi::Game<T> &game);
+[[nodiscard]]
+static inline ExitOr<hamurabi::RoundInput> ExtractCompactRoundInput(std::istream &istream, OutputSink &sink,
+                                                                    const hamurabi::Game<T> &game);
+
+extern const hamurabi::string_literal kSaveFileName;
 
 template<class T>
 [[nodiscard]]
-static inline hamurabi::ser::ExtractResult ExtractGame(std::istream &istream, std::ostream &ostream,
+static inline hamurabi::ser::ExtractResult ExtractGame(std::istream &istream, OutputSink &sink,
                                                        std::fstream &file, hamurabi::Game<T> &game);
 
 enum class ContinueOrStartNew {
@@ -89,7 +168,7 @@ extern const hamurabi::string_literal kStartNewCommand;
 static inline constexpr bool CanStartNew(std::string_view string) noexcept;
 
 [[nodiscard]]
-static inline ContinueOrStartNew ExtractContinueOrStartNew(std::istream &istream, std::ostream &ostream);
+static inline ContinueOrStartNew ExtractContinueOrStartNew(std::istream &istream, OutputSink &sink);
 
 }
 
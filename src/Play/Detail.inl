@@ -3,101 +3,103 @@
 
 #include "Detail.hpp"
 
+#include <utility>
+
 namespace play::detail {
 
-void InsertGreetings(std::ostream &ostream) {
-    ostream << "                                HAMURABI\n"
-               "               CREATIVE COMPUTING  MORRISTOWN, NEW JERSEY\n\n"
-               "TRY YOUR HAND AT GOVERNING ANCIENT SUMERIA\n"
-               "FOR A TEN-YEAR TERM OF OFFICE.\n\n";
+void InsertGreetings(OutputSink &sink) {
+    sink << "                                HAMURABI\n"
+            "               CREATIVE COMPUTING  MORRISTOWN, NEW JERSEY\n\n"
+            "TRY YOUR HAND AT GOVERNING ANCIENT SUMERIA\n"
+            "FOR A TEN-YEAR TERM OF OFFICE.\n\n";
 }
 
-void InsertNotEnoughArea(std::ostream &ostream, const hamurabi::NotEnoughArea error) {
-    ostream << "HAMURABI: THINK AGAIN. YOU OWN ONLY "
-            << error.Area() << " ACRES. NOW THEN,\n";
+void InsertNotEnoughArea(OutputSink &sink, const hamurabi::NotEnoughArea error) {
+    sink << "HAMURABI: THINK AGAIN. YOU OWN ONLY "
+         << error.Area() << " ACRES. NOW THEN,\n";
 }
 
-void InsertNotEnoughGrain(std::ostream &ostream, const hamurabi::NotEnoughGrain error) {
-    ostream << "HAMURABI: THINK AGAIN. YOU HAVE ONLY\n"
-            << error.Grain() << " BUSHELS OF GRAIN. NOW THEN,\n";
+void InsertNotEnoughGrain(OutputSink &sink, const hamurabi::NotEnoughGrain error) {
+    sink << "HAMURABI: THINK AGAIN. YOU HAVE ONLY\n"
+         << error.Grain() << " BUSHELS OF GRAIN. NOW THEN,\n";
 }
 
-void InsertNotEnoughPeople(std::ostream &ostream, const hamurabi::NotEnoughPeople error) {
-    ostream << "HAMURABI: THINK AGAIN. YOU HAVE ONLY "
-            << error.Population() << " PEOPLE TO TEND THE FIELDS! NOW THEN,\n";
+void InsertNotEnoughPeople(OutputSink &sink, const hamurabi::NotEnoughPeople error) {
+    sink << "HAMURABI: THINK AGAIN. YOU HAVE ONLY "
+         << error.Population() << " PEOPLE TO TEND THE FIELDS! NOW THEN,\n";
 }
 
-void InsertGameOver(std::ostream &ostream, const hamurabi::GameOver game_over) {
-    ostream << "YOU STARVED " << game_over.DeadFromHunger() << " PEOPLE IN ONE YEAR!!!\n"
-            << "DUE TO THIS EXTREME MISMANAGEMENT YOU HAVE NOT ONLY\n"
-               "BEEN IMPEACHED AND THROWN OUT OF OFFICE BUT YOU HAVE\n"
-               "ALSO BEEN DECLARED NATIONAL FINK!!!!\n";
+void InsertGameOver(OutputSink &sink, const hamurabi::GameOver game_over) {
+    sink << "YOU STARVED " << game_over.DeadFromHunger() << " PEOPLE IN ONE YEAR!!!\n"
+         << "DUE TO THIS EXTREME MISMANAGEMENT YOU HAVE NOT ONLY\n"
+            "BEEN IMPEACHED AND THROWN OUT OF OFFICE BUT YOU HAVE\n"
+            "ALSO BEEN DECLARED NATIONAL FINK!!!!\n";
 }
 
 template<class T>
-void InsertGameState(std::ostream &ostream, const hamurabi::Game<T> &game) {
-    ostream << "HAMURABI:  I BEG TO REPORT TO YOU,\n"
-               "IN YEAR " << game.CurrentRound() << ",";
+void InsertGameState(OutputSink &sink, const hamurabi::Game<T> &game) {
+    sink << "HAMURABI:  I BEG TO REPORT TO YOU,\n"
+            "IN YEAR " << game.CurrentRound() << ",";
     if (game.DeadFromHunger() > 0) {
-        ostream << " " << game.DeadFromHunger() << " PEOPLE STARVED,";
+        sink << " " << game.DeadFromHunger() << " PEOPLE STARVED,";
     }
     if (game.Arrived() > 0) {
-        ostream << " " << game.Arrived() << " PEOPLE CAME TO THE CITY,";
+        sink << " " << game.Arrived() << " PEOPLE CAME TO THE CITY,";
     }
-    ostream << "\n";
+    sink << "\n";
 
     if (game.IsPlague()) {
-        ostream << "A HORRIBLE PLAGUE STRUCK!  HALF THE PEOPLE DIED.\n";
+        sink << "A HORRIBLE PLAGUE STRUCK!  HALF THE PEOPLE DIED.\n";
     }
-    ostream << "POPULATION IS NOW " << game.Population() << ".\n"
-            << "THE CITY NOW OWNS " << game.Area() << " ACRES.\n"
-            << "YOU HARVESTED " << game.GrainFromAcre() << " BUSHELS PER ACRE.\n";
+    sink << "POPULATION IS NOW " << game.Population() << ".\n"
+         << "THE CITY NOW OWNS " << game.Area() << " ACRES.\n"
+         << "YOU HARVESTED " << game.GrainFromAcre() << " BUSHELS PER ACRE.\n";
     if (game.GrainEatenByRats() > 0) {
-        ostream << "RATS ATE " << game.GrainEatenByRats() << " BUSHELS.\n";
+        sink << "RATS ATE " << game.GrainEatenByRats() << " BUSHELS.\n";
     }
-    ostream << "YOU NOW HAVE " << game.Grain() << " BUSHELS IN STORE.\n"
-            << "LAND IS TRADING AT " << game.AcrePrice() << " BUSHELS PER ACRE.\n";
+    sink << "YOU NOW HAVE " << game.Grain() << " BUSHELS IN STORE.\n"
+         << "LAND IS TRADING AT " << game.AcrePrice() << " BUSHELS PER ACRE.\n";
 }
 
-void InsertGameStatistics(std::ostream &ostream, const hamurabi::Statistics statistics) {
-    ostream << "IN YOUR 10-YEAR TERM OF OFFICE, " << statistics.AverageDeadFromHungerPercent() << " PERCENT OF THE\n"
-            << "POPULATION STARVED PER YEAR ON THE AVERAGE, I.E. A TOTAL OF\n"
-            << statistics.DeadFromHunger() << " PEOPLE DIED!!\n"
-            << "YOU STARTED WITH 10 ACRES PER PERSON AND ENDED WITH\n"
-            << statistics.AreaByPerson() << " ACRES PER PERSON\n";
+void InsertGameStatistics(OutputSink &sink, const hamurabi::Statistics statistics) {
+    sink << "IN YOUR 10-YEAR TERM OF OFFICE, " << statistics.AverageDeadFromHungerPercent() << " PERCENT OF THE\n"
+         << "POPULATION STARVED PER YEAR ON THE AVERAGE, I.E. A TOTAL OF\n"
+         << statistics.DeadFromHunger() << " PEOPLE DIED!!\n"
+         << "YOU STARTED WITH 10 ACRES PER PERSON AND ENDED WITH\n"
+         << statistics.AreaByPerson() << " ACRES PER PERSON\n";
 
     const auto rank = statistics.Rank();
     switch (rank) {
         case hamurabi::Rank::D: {
-            ostream << "THE PEOPLE (REMAINING) FIND YOU AN UNPLEASANT RULER, AND,\n"
-                       "FRANKLY, HATE YOUR GUTS!\n";
+            sink << "THE PEOPLE (REMAINING) FIND YOU AN UNPLEASANT RULER, AND,\n"
+                    "FRANKLY, HATE YOUR GUTS!\n";
             break;
         }
         case hamurabi::Rank::C: {
-            ostream << "YOUR HEAVY-HANDED PERFORMANCE SMACKS OF NERO AND IVAN IV.\n";
+            sink << "YOUR HEAVY-HANDED PERFORMANCE SMACKS OF NERO AND IVAN IV.\n";
             break;
         }
         case hamurabi::Rank::B: {
-            ostream << "YOUR PERFORMANCE COULD HAVE BEEN SOMEWHAT BETTER, BUT\n"
-                       "REALLY WASN'T TOO BAD AT ALL. PEOPLE\n"
-                       "DEARLY LIKE TO SEE YOU ASSASSINATED BUT WE ALL HAVE OUR\n"
-                       "TRIVIAL PROBLEMS.\n";
+            sink << "YOUR PERFORMANCE COULD HAVE BEEN SOMEWHAT BETTER, BUT\n"
+                    "REALLY WASN'T TOO BAD AT ALL. PEOPLE\n"
+                    "DEARLY LIKE TO SEE YOU ASSASSINATED BUT WE ALL HAVE OUR\n"
+                    "TRIVIAL PROBLEMS.\n";
             break;
         }
         case hamurabi::Rank::A: {
-            ostream << "A FANTASTIC PERFORMANCE!!! CHARLEMAGNE, DISRAELI, AND\n"
-                       "JEFFERSON COMBINED COULD NOT HAVE DONE BETTER!\n";
+            sink << "A FANTASTIC PERFORMANCE!!! CHARLEMAGNE, DISRAELI, AND\n"
+                    "JEFFERSON COMBINED COULD NOT HAVE DONE BETTER!\n";
             break;
         }
     }
 }
 
-void InsertGoodbye(std::ostream &ostream) {
-    ostream << "\nSO LONG FOR NOW.\n";
+void InsertGoodbye(OutputSink &sink) {
+    sink << "\nSO LONG FOR NOW.\n";
 }
 
-void InsertOldGameFound(std::ostream &ostream) {
-    ostream << "HAMURABI:  I FOUND SOME OLD PAPERS OF YOUR GOVERNANCE!\n";
+void InsertOldGameFound(OutputSink &sink) {
+    sink << "HAMURABI:  I FOUND SOME OLD PAPERS OF YOUR GOVERNANCE!\n";
 }
 
 constexpr hamurabi::string_literal kExitCommand = "exit";
@@ -106,34 +108,56 @@ constexpr bool CanExit(const std::string_view string) noexcept {
     return hamurabi::detail::Trim(string) == kExitCommand;
 }
 
+constexpr hamurabi::string_literal kCannotDoMessage = "HAMURABI: I CANNOT DO WHAT YOU WISH.  NOW THEN,\n";
+
 template<std::unsigned_integral T>
-ExitOr<T> ExtractUnsigned(std::istream &istream, std::ostream &ostream, const std::string_view message) {
-    const auto error_message = "HAMURABI: I CANNOT DO WHAT YOU WISH.  NOW THEN,\n";
+std::optional<ExitOr<T>> ParseUnsigned(const std::string_view line) {
+    if (CanExit(line)) {
+        return Exit{};
+    }
+    // converts input into integer
     std::make_signed_t<T> value;
-    std::string buffer;
+    try {
+        value = std::stoll(std::string{line});
+    } catch (const std::logic_error &) {
+        return std::nullopt;
+    }
+    // checks for negative values
+    if (value < 0) {
+        return std::nullopt;
+    }
+    return static_cast<T>(value);
+}
 
+template<std::unsigned_integral T>
+Task<ExitOr<T>> AwaitUnsigned(LineChannel &channel, const std::string_view message) {
     while (true) {
-        // prints message
-        ostream << message;
-        // gets new line and check for exit
-        std::getline(istream, buffer);
-        if (CanExit(buffer)) {
-            return Exit{};
-        }
-        // converts input into integer
-        try {
-            value = std::stoll(buffer);
-        } catch (const std::logic_error &) {
-            ostream << error_message;
-            continue;
-        }
-        // checks for negative values
-        if (value < 0) {
-            ostream << error_message;
-            continue;
+        channel.Sink() << message;
+        const auto line = co_await channel.NextLine();
+        if (auto value = ParseUnsigned<T>(line)) {
+            co_return *value;
         }
-        return static_cast<T>(value);
+        channel.Sink() << kCannotDoMessage;
+    }
+}
+
+template<class R>
+R ExtractLines(Task<R> task, LineChannel &channel, std::istream &istream, OutputSink &sink) {
+    std::string buffer;
+    channel.Start(task, sink);
+    while (!task.IsDone()) {
+        // prints prompt together with everything reported before it
+        sink.Flush();
+        std::getline(istream, buffer);
+        channel.Feed(buffer, sink);
     }
+    return task.Result();
+}
+
+template<std::unsigned_integral T>
+ExitOr<T> ExtractUnsigned(std::istream &istream, OutputSink &sink, const std::string_view message) {
+    LineChannel channel;
+    return ExtractLines(AwaitUnsigned<T>(channel, message), channel, istream, sink);
 }
 
 template<class... Ts>
@@ -144,150 +168,293 @@ struct overloaded : Ts ... {
 template<class... Ts>
 overloaded(Ts...) -> overloaded<Ts...>;
 
+constexpr hamurabi::string_literal kAreaToBuyMessage = "HOW MANY ACRES DO YOU WISH TO BUY? ";
+constexpr hamurabi::string_literal kAreaToSellMessage = "HOW MANY ACRES DO YOU WISH TO SELL? ";
+constexpr hamurabi::string_literal kGrainToFeedMessage = "HOW MANY BUSHELS DO YOU WISH TO FEED YOUR PEOPLE? ";
+constexpr hamurabi::string_literal kAreaToPlantMessage = "HOW MANY ACRES DO YOU WISH TO PLANT WITH SEED? ";
+
 template<class T>
-ExitOr<hamurabi::AreaToBuy> ExtractAreaToBuy(std::istream &istream, std::ostream &ostream,
-                                             const hamurabi::Game<T> &game) {
-    ExitOr<hamurabi::Acres> input;
-    std::optional<hamurabi::AreaToBuyResult> result;
-    bool try_again = true;
-    while (try_again) {
-        input = ExtractUnsigned<hamurabi::Acres>(
-            istream, ostream, "HOW MANY ACRES DO YOU WISH TO BUY? ");
+Task<ExitOr<hamurabi::AreaToBuy>> AwaitAreaToBuy(LineChannel &channel, const hamurabi::Game<T> &game) {
+    while (true) {
+        const auto input = co_await AwaitUnsigned<hamurabi::Acres>(channel, kAreaToBuyMessage);
         if (std::holds_alternative<Exit>(input)) {
-            return Exit{};
+            co_return Exit{};
+        }
+        const auto result = hamurabi::AreaToBuy::New(std::get<hamurabi::Acres>(input), game);
+        if (std::holds_alternative<hamurabi::AreaToBuy>(result)) {
+            co_return std::get<hamurabi::AreaToBuy>(result);
         }
-        const auto area_to_buy = std::get<hamurabi::Acres>(input);
-        result = hamurabi::AreaToBuy::New(area_to_buy, game);
         std::visit(detail::overloaded{
-            [&try_again](hamurabi::AreaToBuy) { try_again = false; },
-            [&ostream](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(ostream, error); },
-        }, result.value());
+            [](hamurabi::AreaToBuy) {},
+            [&channel](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(channel.Sink(), error); },
+        }, result);
     }
-    return std::get<hamurabi::AreaToBuy>(result.value());
 }
 
 template<class T>
-ExitOr<hamurabi::AreaToSell> ExtractAreaToSell(std::istream &istream, std::ostream &ostream,
-                                               const hamurabi::Game<T> &game) {
-    ExitOr<hamurabi::Acres> input;
-    std::optional<hamurabi::AreaToSellResult> result;
-    bool try_again = true;
-    while (try_again) {
-        input = ExtractUnsigned<hamurabi::Acres>(
-            istream, ostream, "HOW MANY ACRES DO YOU WISH TO SELL? ");
+Task<ExitOr<hamurabi::AreaToSell>> AwaitAreaToSell(LineChannel &channel, const hamurabi::Game<T> &game) {
+    while (true) {
+        const auto input = co_await AwaitUnsigned<hamurabi::Acres>(channel, kAreaToSellMessage);
         if (std::holds_alternative<Exit>(input)) {
-            return Exit{};
+            co_return Exit{};
+        }
+        const auto result = hamurabi::AreaToSell::New(std::get<hamurabi::Acres>(input), game);
+        if (std::holds_alternative<hamurabi::AreaToSell>(result)) {
+            co_return std::get<hamurabi::AreaToSell>(result);
         }
-        const auto area_to_sell = std::get<hamurabi::Acres>(input);
-        result = hamurabi::AreaToSell::New(area_to_sell, game);
         std::visit(detail::overloaded{
-            [&try_again](hamurabi::AreaToSell) { try_again = false; },
-            [&ostream](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(ostream, error); },
-        }, result.value());
+            [](hamurabi::AreaToSell) {},
+            [&channel](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(channel.Sink(), error); },
+        }, result);
     }
-    return std::get<hamurabi::AreaToSell>(result.value());
 }
 
 template<class T>
-ExitOr<hamurabi::GrainToFeed> ExtractGrainToFeed(std::istream &istream, std::ostream &ostream,
-                                                 const hamurabi::Game<T> &game) {
-    ExitOr<hamurabi::Bushels> input;
-    std::optional<hamurabi::GrainToFeedResult> result;
-    bool try_again = true;
-    while (try_again) {
-        input = ExtractUnsigned<hamurabi::Bushels>(
-            istream, ostream, "HOW MANY BUSHELS DO YOU WISH TO FEED YOUR PEOPLE? ");
+Task<ExitOr<hamurabi::GrainToFeed>> AwaitGrainToFeed(LineChannel &channel, const hamurabi::Game<T> &game) {
+    while (true) {
+        const auto input = co_await AwaitUnsigned<hamurabi::Bushels>(channel, kGrainToFeedMessage);
         if (std::holds_alternative<Exit>(input)) {
-            return Exit{};
+            co_return Exit{};
+        }
+        const auto result = hamurabi::GrainToFeed::New(std::get<hamurabi::Bushels>(input), game);
+        if (std::holds_alternative<hamurabi::GrainToFeed>(result)) {
+            co_return std::get<hamurabi::GrainToFeed>(result);
         }
-        const auto grain_to_feed = std::get<hamurabi::Bushels>(input);
-        result = hamurabi::GrainToFeed::New(grain_to_feed, game);
         std::visit(detail::overloaded{
-            [&try_again](hamurabi::GrainToFeed) { try_again = false; },
-            [&ostream](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(ostream, error); },
-        }, result.value());
+            [](hamurabi::GrainToFeed) {},
+            [&channel](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(channel.Sink(), error); },
+        }, result);
     }
-    return std::get<hamurabi::GrainToFeed>(result.value());
 }
 
 template<class T>
-ExitOr<hamurabi::AreaToPlant> ExtractAreaToPlant(std::istream &istream, std::ostream &ostream,
-                                                 const hamurabi::Game<T> &game) {
-    ExitOr<hamurabi::Acres> input;
-    std::optional<hamurabi::AreaToPlantResult> result;
-    bool try_again = true;
-    while (try_again) {
-        input = ExtractUnsigned<hamurabi::Acres>(
-            istream, ostream, "HOW MANY ACRES DO YOU WISH TO PLANT WITH SEED? ");
+Task<ExitOr<hamurabi::AreaToPlant>> AwaitAreaToPlant(LineChannel &channel, const hamurabi::Game<T> &game) {
+    while (true) {
+        const auto input = co_await AwaitUnsigned<hamurabi::Acres>(channel, kAreaToPlantMessage);
         if (std::holds_alternative<Exit>(input)) {
-            return Exit{};
+            co_return Exit{};
+        }
+        const auto result = hamurabi::AreaToPlant::New(std::get<hamurabi::Acres>(input), game);
+        if (std::holds_alternative<hamurabi::AreaToPlant>(result)) {
+            co_return std::get<hamurabi::AreaToPlant>(result);
         }
-        const auto area_to_plant = std::get<hamurabi::Acres>(input);
-        result = hamurabi::AreaToPlant::New(area_to_plant, game);
         std::visit(detail::overloaded{
-            [&try_again](hamurabi::AreaToPlant) { try_again = false; },
-            [&ostream](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(ostream, error); },
-            [&ostream](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(ostream, error); },
-            [&ostream](hamurabi::NotEnoughPeople error) { InsertNotEnoughPeople(ostream, error); },
-        }, result.value());
+            [](hamurabi::AreaToPlant) {},
+            [&channel](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(channel.Sink(), error); },
+            [&channel](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(channel.Sink(), error); },
+            [&channel](hamurabi::NotEnoughPeople error) { InsertNotEnoughPeople(channel.Sink(), error); },
+        }, result);
     }
-    return std::get<hamurabi::AreaToPlant>(result.value());
 }
 
 template<class T>
-ExitOr<hamurabi::RoundInput> ExtractRoundInput(std::istream &istream, std::ostream &ostream,
-                                               const hamurabi::Game<T> &game) {
-    std::optional<hamurabi::RoundInputResult> result;
-    bool try_again = true;
-    while (try_again) {
+Task<ExitOr<hamurabi::RoundInput>> AwaitRoundInput(LineChannel &channel, const hamurabi::Game<T> &game) {
+    while (true) {
         // if we got area to buy?
-        const auto area_to_buy_or = ExtractAreaToBuy(istream, ostream, game);
+        const auto area_to_buy_or = co_await AwaitAreaToBuy(channel, game);
         if (std::holds_alternative<Exit>(area_to_buy_or)) {
-            return Exit{};
+            co_return Exit{};
         }
-        const auto area_to_buy = std::get<hamurabi::AreaToBuy>(area_to_buy_or);
         // if we got area to sell?
-        const auto area_to_sell_or = ExtractAreaToSell(istream, ostream, game);
+        const auto area_to_sell_or = co_await AwaitAreaToSell(channel, game);
         if (std::holds_alternative<Exit>(area_to_sell_or)) {
-            return Exit{};
+            co_return Exit{};
         }
-        const auto area_to_sell = std::get<hamurabi::AreaToSell>(area_to_sell_or);
         // if we got grain to feed our people?
-        const auto grain_to_feed_or = ExtractGrainToFeed(istream, ostream, game);
+        const auto grain_to_feed_or = co_await AwaitGrainToFeed(channel, game);
         if (std::holds_alternative<Exit>(grain_to_feed_or)) {
-            return Exit{};
+            co_return Exit{};
         }
-        const auto grain_to_feed = std::get<hamurabi::GrainToFeed>(grain_to_feed_or);
         // if we got area to plant our crops to?
-        const auto area_to_plant_or = ExtractAreaToPlant(istream, ostream, game);
+        const auto area_to_plant_or = co_await AwaitAreaToPlant(channel, game);
         if (std::holds_alternative<Exit>(area_to_plant_or)) {
-            return Exit{};
+            co_return Exit{};
         }
-        const auto area_to_plant = std::get<hamurabi::AreaToPlant>(area_to_plant_or);
         // checks for round input result
-        result = hamurabi::RoundInput::New(area_to_buy, area_to_sell, grain_to_feed, area_to_plant, game);
+        const auto result = hamurabi::RoundInput::New(std::get<hamurabi::AreaToBuy>(area_to_buy_or),
+                                                      std::get<hamurabi::AreaToSell>(area_to_sell_or),
+                                                      std::get<hamurabi::GrainToFeed>(grain_to_feed_or),
+                                                      std::get<hamurabi::AreaToPlant>(area_to_plant_or),
+                                                      game);
+        if (std::holds_alternative<hamurabi::RoundInput>(result)) {
+            channel.Sink() << "\n";
+            co_return std::get<hamurabi::RoundInput>(result);
+        }
         std::visit(detail::overloaded{
-            [&try_again](hamurabi::RoundInput) { try_again = false; },
-            [&ostream](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(ostream, error); },
-            [&ostream](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(ostream, error); },
-            [&ostream](hamurabi::NotEnoughPeople error) { InsertNotEnoughPeople(ostream, error); },
-        }, result.value());
+            [](hamurabi::RoundInput) {},
+            [&channel](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(channel.Sink(), error); },
+            [&channel](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(channel.Sink(), error); },
+            [&channel](hamurabi::NotEnoughPeople error) { InsertNotEnoughPeople(channel.Sink(), error); },
+        }, result);
     }
-    ostream << "\n";
-    return std::get<hamurabi::RoundInput>(result.value());
 }
 
-constexpr hamurabi::string_literal kSaveFileName = "game.yaml";
+// numbers are read in place with from_chars, the line is never copied
+std::optional<ExitOr<RoundLine>> ParseRoundLine(const std::string_view line) noexcept {
+    if (CanExit(line)) {
+        return Exit{};
+    }
+    RoundLine round_line{};
+    std::size_t offset = 0;
+    const auto is_parsed = hamurabi::detail::ExtractNumber(line, offset, round_line.area_to_buy) &&
+        hamurabi::detail::ExtractNumber(line, offset, round_line.area_to_sell) &&
+        hamurabi::detail::ExtractNumber(line, offset, round_line.grain_to_feed) &&
+        hamurabi::detail::ExtractNumber(line, offset, round_line.area_to_plant);
+    if (!is_parsed || hamurabi::detail::SkipSpaces(line, offset) != line.size()) {
+        return std::nullopt;
+    }
+    return round_line;
+}
+
+constexpr hamurabi::string_literal kRoundInputMessage =
+    "HOW MANY ACRES TO BUY, TO SELL, BUSHELS TO FEED AND ACRES TO PLANT? ";
+
+void InsertRejected(OutputSink &sink, const std::string_view component) {
+    sink << "HAMURABI: I CANNOT ACCEPT THE " << component << ".\n";
+}
+
+template<class V>
+void InsertRejected(OutputSink &sink, const std::string_view component, const V &result) {
+    InsertRejected(sink, component);
+    std::visit(detail::overloaded{
+        [&sink](hamurabi::NotEnoughArea error) { InsertNotEnoughArea(sink, error); },
+        [&sink](hamurabi::NotEnoughGrain error) { InsertNotEnoughGrain(sink, error); },
+        [&sink](hamurabi::NotEnoughPeople error) { InsertNotEnoughPeople(sink, error); },
+        [](const auto &) {},
+    }, result);
+}
 
 template<class T>
-void InsertGame(std::fstream &file, const hamurabi::Game<T> &game) {
-    file.open(kSaveFileName, std::fstream::out | std::fstream::trunc);
-    hamurabi::ser::InsertGame(file, game, hamurabi::ser::Format::YAML);
-    file.close();
+Task<ExitOr<hamurabi::RoundInput>> AwaitCompactRoundInput(LineChannel &channel, const hamurabi::Game<T> &game) {
+    // the game does not change while the player retries
+    const hamurabi::FeasibleRegion region{game};
+    while (true) {
+        channel.Sink() << kRoundInputMessage;
+        const auto round_line_or = ParseRoundLine(co_await channel.NextLine());
+        if (!round_line_or.has_value()) {
+            channel.Sink() << kCannotDoMessage;
+            continue;
+        }
+        if (std::holds_alternative<Exit>(*round_line_or)) {
+            co_return Exit{};
+        }
+        const auto round_line = std::get<RoundLine>(*round_line_or);
+
+        // the first component which does not fit is the one reported
+        const auto area_to_buy = hamurabi::AreaToBuy::New(round_line.area_to_buy, game, region);
+        const auto area_to_sell = hamurabi::AreaToSell::New(round_line.area_to_sell, game, region);
+        const auto grain_to_feed = hamurabi::GrainToFeed::New(round_line.grain_to_feed, game, region);
+        const auto area_to_plant = hamurabi::AreaToPlant::New(round_line.area_to_plant, game, region);
+        if (!std::holds_alternative<hamurabi::AreaToBuy>(area_to_buy)) {
+            InsertRejected(channel.Sink(), "ACRES TO BUY", area_to_buy);
+            continue;
+        }
+        if (!std::holds_alternative<hamurabi::AreaToSell>(area_to_sell)) {
+            InsertRejected(channel.Sink(), "ACRES TO SELL", area_to_sell);
+            continue;
+        }
+        if (!std::holds_alternative<hamurabi::GrainToFeed>(grain_to_feed)) {
+            InsertRejected(channel.Sink(), "BUSHELS TO FEED", grain_to_feed);
+            continue;
+        }
+        if (!std::holds_alternative<hamurabi::AreaToPlant>(area_to_plant)) {
+            InsertRejected(channel.Sink(), "ACRES TO PLANT", area_to_plant);
+            continue;
+        }
+        const auto result = hamurabi::RoundInput::New(std::get<hamurabi::AreaToBuy>(area_to_buy),
+                                                      std::get<hamurabi::AreaToSell>(area_to_sell),
+                                                      std::get<hamurabi::GrainToFeed>(grain_to_feed),
+                                                      std::get<hamurabi::AreaToPlant>(area_to_plant),
+                                                      game, region);
+        if (std::holds_alternative<hamurabi::RoundInput>(result)) {
+            channel.Sink() << "\n";
+            co_return std::get<hamurabi::RoundInput>(result);
+        }
+        InsertRejected(channel.Sink(), "ROUND AS A WHOLE", result);
+    }
+}
+
+template<class T>
+Task<std::optional<hamurabi::Statistics>> AwaitGame(LineChannel &channel, hamurabi::Game<T> game,
+                                                    const InputMode input_mode) {
+    InsertGreetings(channel.Sink());
+    InsertGameState(channel.Sink(), game);
+    std::optional<hamurabi::Statistics> statistics;
+    bool can_play = true;
+    while (can_play) {
+        const auto input_or = input_mode == InputMode::Compact
+            ? co_await AwaitCompactRoundInput(channel, game)
+            : co_await AwaitRoundInput(channel, game);
+        if (std::holds_alternative<Exit>(input_or)) {
+            break;
+        }
+        const auto round_result = game.PlayRound(std::get<hamurabi::RoundInput>(input_or));
+        std::visit(detail::overloaded{
+            [&channel, &can_play](hamurabi::GameOver game_over) {
+                InsertGameOver(channel.Sink(), game_over);
+                can_play = false;
+            },
+            [&channel, &game = std::as_const(game)](hamurabi::Continue) {
+                InsertGameState(channel.Sink(), game);
+            },
+            [&channel, &game = std::as_const(game), &statistics, &can_play](hamurabi::GameEnd) {
+                statistics = game.Statistics();
+                InsertGameState(channel.Sink(), game);
+                InsertGameStatistics(channel.Sink(), statistics.value());
+                can_play = false;
+            },
+        }, round_result);
+    }
+    InsertGoodbye(channel.Sink());
+    co_return statistics;
+}
+
+template<class T>
+ExitOr<hamurabi::AreaToBuy> ExtractAreaToBuy(std::istream &istream, OutputSink &sink,
+                                             const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitAreaToBuy(channel, game), channel, istream, sink);
+}
+
+template<class T>
+ExitOr<hamurabi::AreaToSell> ExtractAreaToSell(std::istream &istream, OutputSink &sink,
+                                               const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitAreaToSell(channel, game), channel, istream, sink);
 }
 
 template<class T>
-hamurabi::ser::ExtractResult ExtractGame(std::istream &istream, std::ostream &ostream,
+ExitOr<hamurabi::GrainToFeed> ExtractGrainToFeed(std::istream &istream, OutputSink &sink,
+                                                 const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitGrainToFeed(channel, game), channel, istream, sink);
+}
+
+template<class T>
+ExitOr<hamurabi::AreaToPlant> ExtractAreaToPlant(std::istream &istream, OutputSink &sink,
+                                                 const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitAreaToPlant(channel, game), channel, istream, sink);
+}
+
+template<class T>
+ExitOr<hamurabi::RoundInput> ExtractRoundInput(std::istream &istream, OutputSink &sink,
+                                               const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitRoundInput(channel, game), channel, istream, sink);
+}
+
+template<class T>
+ExitOr<hamurabi::RoundInput> ExtractCompactRoundInput(std::istream &istream, OutputSink &sink,
+                                                      const hamurabi::Game<T> &game) {
+    LineChannel channel;
+    return ExtractLines(AwaitCompactRoundInput(channel, game), channel, istream, sink);
+}
+
+constexpr hamurabi::string_literal kSaveFileName = "game.yaml";
+
+template<class T>
+hamurabi::ser::ExtractResult ExtractGame(std::istream &istream, OutputSink &sink,
                                          std::fstream &file, hamurabi::Game<T> &game) {
     namespace ser = hamurabi::serialization;
 
@@ -296,8 +463,8 @@ hamurabi::ser::ExtractResult ExtractGame(std::istream &istream, std::ostream &os
         file.clear();
         return ser::ExtractResult::Success;
     }
-    InsertOldGameFound(ostream);
-    const auto continue_or_start_new = ExtractContinueOrStartNew(istream, ostream);
+    InsertOldGameFound(sink);
+    const auto continue_or_start_new = ExtractContinueOrStartNew(istream, sink);
     switch (continue_or_start_new) {
         case ContinueOrStartNew::StartNew: {
             file.close();
@@ -325,13 +492,13 @@ constexpr bool CanStartNew(std::string_view string) noexcept {
 }
 
 [[nodiscard]]
-ContinueOrStartNew ExtractContinueOrStartNew(std::istream &istream, std::ostream &ostream) {
+ContinueOrStartNew ExtractContinueOrStartNew(std::istream &istream, OutputSink &sink) {
     constexpr auto message = "SHALL WE CONTINUE? OR MAYBE START WITH A CLEAN NEW PAPER? ";
-    constexpr auto error_message = "HAMURABI: I CANNOT DO WHAT YOU WISH.  NOW THEN,\n";
     std::string buffer;
 
     while (true) {
-        ostream << message;
+        sink << message;
+        sink.Flush();
         std::getline(istream, buffer);
         if (CanContinue(buffer)) {
             return ContinueOrStartNew::Continue;
@@ -339,7 +506,7 @@ ContinueOrStartNew ExtractContinueOrStartNew(std::istream &istream, std::ostream
         if (CanStartNew(buffer)) {
             return ContinueOrStartNew::StartNew;
         }
-        ostream << error_message;
+        sink << kCannotDoMessage;
     }
 }
 
@@ -1,13 +1,17 @@
 #ifndef PLAY_HAMURABI
 #define PLAY_HAMURABI
 
-#include "Detail.hpp"
+#include "Autosave.hpp"
 
 namespace play {
 
+extern const hamurabi::string_literal kCompactFlag;
+
 template<class T>
 void Hamurabi(std::istream &istream, std::ostream &ostream,
-              std::fstream &file, hamurabi::Game<T> &game);
+              std::fstream &file, hamurabi::Game<T> &game,
+              const AutosaveOptions &autosave_options = {},
+              InputMode input_mode = InputMode::Prompted);
 
 }
 
@@ -1,46 +1,56 @@
 #ifndef PLAY_HAMURABI_INL
 #define PLAY_HAMURABI_INL
 
+#include <utility>
+
 namespace play {
 
+constexpr hamurabi::string_literal kCompactFlag = "--compact";
+
 template<class T>
 void Hamurabi(std::istream &istream, std::ostream &ostream,
-              std::fstream &file, hamurabi::Game<T> &game) {
-    detail::InsertGreetings(ostream);
-    const auto extract_game_result = detail::ExtractGame(istream, ostream, file, game);
+              std::fstream &file, hamurabi::Game<T> &game,
+              const AutosaveOptions &autosave_options,
+              const InputMode input_mode) {
+    OutputSink sink{ostream};
+    detail::InsertGreetings(sink);
+    const auto extract_game_result = detail::ExtractGame(istream, sink, file, game);
     if (extract_game_result == hamurabi::ser::ExtractResult::Error) {
         return;
     }
 
-    detail::InsertGameState(ostream, game);
+    Autosave autosave{autosave_options};
+    detail::InsertGameState(sink, game);
     bool can_play = true;
     while (can_play) {
-        detail::InsertGame(file, game);
-        const auto input_or = detail::ExtractRoundInput(istream, ostream, game);
+        autosave.Save(game);
+        const auto input_or = input_mode == InputMode::Compact
+            ? detail::ExtractCompactRoundInput(istream, sink, game)
+            : detail::ExtractRoundInput(istream, sink, game);
         if (std::holds_alternative<detail::Exit>(input_or)) {
             break;
         }
         const auto input = std::get<hamurabi::RoundInput>(input_or);
         const auto round_result = game.PlayRound(input);
         std::visit(detail::overloaded{
-            [&ostream, &can_play](hamurabi::GameOver game_over) {
-                detail::InsertGameOver(ostream, game_over);
+            [&sink, &can_play](hamurabi::GameOver game_over) {
+                detail::InsertGameOver(sink, game_over);
                 can_play = false;
             },
-            [&ostream, &game = std::as_const(game)](hamurabi::Continue) {
-                detail::InsertGameState(ostream, game);
+            [&sink, &game = std::as_const(game)](hamurabi::Continue) {
+                detail::InsertGameState(sink, game);
             },
-            [&ostream, &game = std::as_const(game), &can_play](hamurabi::GameEnd) {
+            [&sink, &game = std::as_const(game), &can_play](hamurabi::GameEnd) {
                 const auto statistics = game.Statistics().value();
-                detail::InsertGameState(ostream, game);
-                detail::InsertGameStatistics(ostream, statistics);
+                detail::InsertGameState(sink, game);
+                detail::InsertGameStatistics(sink, statistics);
                 can_play = false;
             },
         }, round_result);
     }
 
-    detail::InsertGame(file, game);
-    detail::InsertGoodbye(ostream);
+    autosave.SaveOnExit(game);
+    detail::InsertGoodbye(sink);
 }
 
 }
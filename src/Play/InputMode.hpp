@@ -0,0 +1,17 @@
+#ifndef PLAY_INPUT_MODE
+#define PLAY_INPUT_MODE
+
+#include <cstdint>
+
+namespace play {
+
+enum class InputMode : std::uint8_t {
+    // one prompt per number, as the original game asks
+    Prompted,
+    // all four numbers of a round on one line: buy sell feed plant
+    Compact,
+};
+
+}
+
+#endif //PLAY_INPUT_MODE
@@ -0,0 +1,62 @@
+#ifndef PLAY_LINE_CHANNEL
+#define PLAY_LINE_CHANNEL
+
+#include <coroutine>
+#include <string_view>
+
+#include "Task.hpp"
+#include "OutputSink.hpp"
+
+namespace play::detail {
+
+// the only suspension point of the prompt tasks, whoever owns the input hands lines in one at a time
+class LineChannel final {
+  public:
+    class LineAwaiter final {
+      public:
+        explicit LineAwaiter(LineChannel &channel) noexcept;
+
+        [[nodiscard]]
+        bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> reader) const noexcept;
+
+        [[nodiscard]]
+        std::string_view await_resume() const noexcept;
+
+      private:
+        LineChannel *channel_;
+    };
+
+    LineChannel() noexcept;
+
+    LineChannel(const LineChannel &) = delete;
+    LineChannel &operator=(const LineChannel &) = delete;
+
+    // the line is only valid until the task suspends again
+    [[nodiscard]]
+    LineAwaiter NextLine() noexcept;
+
+    // where the tasks print while they run, it is only set while Start or Feed runs them
+    [[nodiscard]]
+    OutputSink &Sink() const noexcept;
+
+    template<class T>
+    void Start(Task<T> &task, OutputSink &sink);
+
+    void Feed(std::string_view line, OutputSink &sink);
+
+    [[nodiscard]]
+    bool IsWaiting() const noexcept;
+
+  private:
+    OutputSink *sink_;
+    std::string_view line_;
+    std::coroutine_handle<> reader_;
+};
+
+}
+
+#include "LineChannel.inl"
+
+#endif //PLAY_LINE_CHANNEL
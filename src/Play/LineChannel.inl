@@ -0,0 +1,58 @@
+#ifndef PLAY_LINE_CHANNEL_INL
+#define PLAY_LINE_CHANNEL_INL
+
+#include <utility>
+
+namespace play::detail {
+
+inline LineChannel::LineAwaiter::LineAwaiter(LineChannel &channel) noexcept
+    : channel_{&channel} {}
+
+inline bool LineChannel::LineAwaiter::await_ready() const noexcept {
+    return false;
+}
+
+inline void LineChannel::LineAwaiter::await_suspend(const std::coroutine_handle<> reader) const noexcept {
+    channel_->reader_ = reader;
+}
+
+inline std::string_view LineChannel::LineAwaiter::await_resume() const noexcept {
+    return channel_->line_;
+}
+
+inline LineChannel::LineChannel() noexcept
+    : sink_{nullptr} {}
+
+inline LineChannel::LineAwaiter LineChannel::NextLine() noexcept {
+    return LineAwaiter{*this};
+}
+
+inline OutputSink &LineChannel::Sink() const noexcept {
+    return *sink_;
+}
+
+template<class T>
+void LineChannel::Start(Task<T> &task, OutputSink &sink) {
+    sink_ = &sink;
+    task.Start();
+    sink_ = nullptr;
+}
+
+inline void LineChannel::Feed(const std::string_view line, OutputSink &sink) {
+    if (!reader_) {
+        return;
+    }
+    sink_ = &sink;
+    line_ = line;
+    std::exchange(reader_, {}).resume();
+    sink_ = nullptr;
+    line_ = {};
+}
+
+inline bool LineChannel::IsWaiting() const noexcept {
+    return static_cast<bool>(reader_);
+}
+
+}
+
+#endif //PLAY_LINE_CHANNEL_INL
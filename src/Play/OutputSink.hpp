@@ -0,0 +1,48 @@
+#ifndef PLAY_OUTPUT_SINK
+#define PLAY_OUTPUT_SINK
+
+#include <string>
+#include <ostream>
+#include <concepts>
+#include <string_view>
+
+namespace play {
+
+// collects a whole report in one reusable buffer, so the stream sees a single write per flush
+class OutputSink final {
+  public:
+    OutputSink(OutputSink &&other) noexcept = default;
+    OutputSink &operator=(OutputSink &&other) noexcept = default;
+
+    OutputSink(const OutputSink &) = delete;
+    OutputSink &operator=(const OutputSink &) = delete;
+
+    // without a stream nothing is flushed, the owner takes the text through Buffer and Consume
+    OutputSink() noexcept;
+
+    explicit OutputSink(std::ostream &ostream);
+
+    ~OutputSink();
+
+    OutputSink &operator<<(std::string_view string);
+
+    template<std::unsigned_integral U>
+    OutputSink &operator<<(U value);
+
+    void Flush();
+
+    [[nodiscard]]
+    std::string_view Buffer() const noexcept;
+
+    void Consume(std::size_t count);
+
+  private:
+    std::ostream *ostream_;
+    std::string buffer_;
+};
+
+}
+
+#include "OutputSink.inl"
+
+#endif //PLAY_OUTPUT_SINK
@@ -0,0 +1,53 @@
+#ifndef PLAY_OUTPUT_SINK_INL
+#define PLAY_OUTPUT_SINK_INL
+
+#include <array>
+#include <limits>
+#include <charconv>
+
+namespace play {
+
+inline OutputSink::OutputSink() noexcept
+    : ostream_{nullptr} {}
+
+inline OutputSink::OutputSink(std::ostream &ostream)
+    : ostream_{&ostream} {}
+
+inline OutputSink::~OutputSink() {
+    Flush();
+}
+
+inline OutputSink &OutputSink::operator<<(const std::string_view string) {
+    buffer_.append(string);
+    return *this;
+}
+
+template<std::unsigned_integral U>
+OutputSink &OutputSink::operator<<(const U value) {
+    std::array<char, std::numeric_limits<U>::digits10 + 1> digits{};
+    const auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+    buffer_.append(digits.data(), end);
+    return *this;
+}
+
+// clear keeps the capacity, so after the first round the buffer does not allocate anymore
+inline void OutputSink::Flush() {
+    if (ostream_ == nullptr || buffer_.empty()) {
+        return;
+    }
+    ostream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    ostream_->flush();
+    buffer_.clear();
+}
+
+inline std::string_view OutputSink::Buffer() const noexcept {
+    return buffer_;
+}
+
+inline void OutputSink::Consume(const std::size_t count) {
+    buffer_.erase(0, count);
+}
+
+}
+
+#endif //PLAY_OUTPUT_SINK_INL
@@ -0,0 +1,33 @@
+#ifndef PLAY_SESSION
+#define PLAY_SESSION
+
+#include <memory>
+
+#include "Detail.hpp"
+
+namespace play {
+
+// a game of Hamurabi which is fed one line at a time, so it never blocks on input
+template<class T>
+class Session final {
+  public:
+    explicit Session(hamurabi::Game<T> game, InputMode input_mode = InputMode::Prompted);
+
+    void Start(OutputSink &sink);
+
+    void Feed(std::string_view line, OutputSink &sink);
+
+    [[nodiscard]]
+    bool IsFinished() const noexcept;
+
+  private:
+    // the channel keeps its address when the session moves, the suspended frame refers to it
+    std::unique_ptr<detail::LineChannel> channel_;
+    detail::Task<std::optional<hamurabi::Statistics>> task_;
+};
+
+}
+
+#include "Session.inl"
+
+#endif //PLAY_SESSION
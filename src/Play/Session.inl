@@ -0,0 +1,30 @@
+#ifndef PLAY_SESSION_INL
+#define PLAY_SESSION_INL
+
+#include <utility>
+
+namespace play {
+
+template<class T>
+Session<T>::Session(hamurabi::Game<T> game, const InputMode input_mode)
+    : channel_{std::make_unique<detail::LineChannel>()},
+      task_{detail::AwaitGame(*channel_, std::move(game), input_mode)} {}
+
+template<class T>
+void Session<T>::Start(OutputSink &sink) {
+    channel_->Start(task_, sink);
+}
+
+template<class T>
+void Session<T>::Feed(const std::string_view line, OutputSink &sink) {
+    channel_->Feed(line, sink);
+}
+
+template<class T>
+bool Session<T>::IsFinished() const noexcept {
+    return task_.IsDone();
+}
+
+}
+
+#endif //PLAY_SESSION_INL
@@ -0,0 +1,63 @@
+#ifndef PLAY_TASK
+#define PLAY_TASK
+
+#include <optional>
+#include <coroutine>
+
+namespace play::detail {
+
+// lazily started coroutine, awaiting it runs it and resumes the awaiter once it returns
+template<class T>
+class Task final {
+  public:
+    struct promise_type final {
+        std::optional<T> value;
+        std::coroutine_handle<> continuation;
+
+        Task get_return_object() noexcept;
+
+        std::suspend_always initial_suspend() const noexcept;
+
+        auto final_suspend() const noexcept;
+
+        void return_value(T result);
+
+        [[noreturn]]
+        void unhandled_exception() const;
+    };
+
+    Task(Task &&other) noexcept;
+    Task &operator=(Task &&other) noexcept;
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task();
+
+    [[nodiscard]]
+    bool await_ready() const noexcept;
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept;
+
+    T await_resume();
+
+    // starts a task nobody awaits, it runs until its first suspension
+    void Start();
+
+    [[nodiscard]]
+    bool IsDone() const noexcept;
+
+    [[nodiscard]]
+    T Result();
+
+  private:
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+}
+
+#include "Task.inl"
+
+#endif //PLAY_TASK
@@ -0,0 +1,102 @@
+#ifndef PLAY_TASK_INL
+#define PLAY_TASK_INL
+
+#include <utility>
+
+namespace play::detail {
+
+template<class T>
+Task<T> Task<T>::promise_type::get_return_object() noexcept {
+    return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+}
+
+template<class T>
+std::suspend_always Task<T>::promise_type::initial_suspend() const noexcept {
+    return {};
+}
+
+// hands control straight to the awaiter, so a chain of tasks does not grow the stack
+template<class T>
+auto Task<T>::promise_type::final_suspend() const noexcept {
+    struct FinalAwaiter final {
+        [[nodiscard]]
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<promise_type> handle) const noexcept {
+            const auto continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+    return FinalAwaiter{};
+}
+
+template<class T>
+void Task<T>::promise_type::return_value(T result) {
+    value.emplace(std::move(result));
+}
+
+// the exception goes to whoever resumed the chain, frames are still released by their tasks
+template<class T>
+void Task<T>::promise_type::unhandled_exception() const {
+    throw;
+}
+
+template<class T>
+Task<T>::Task(const std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle} {}
+
+template<class T>
+Task<T>::Task(Task &&other) noexcept
+    : handle_{std::exchange(other.handle_, {})} {}
+
+template<class T>
+Task<T> &Task<T>::operator=(Task &&other) noexcept {
+    std::swap(handle_, other.handle_);
+    return *this;
+}
+
+template<class T>
+Task<T>::~Task() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+template<class T>
+bool Task<T>::await_ready() const noexcept {
+    return false;
+}
+
+template<class T>
+std::coroutine_handle<> Task<T>::await_suspend(const std::coroutine_handle<> continuation) noexcept {
+    handle_.promise().continuation = continuation;
+    return handle_;
+}
+
+template<class T>
+T Task<T>::await_resume() {
+    return Result();
+}
+
+template<class T>
+void Task<T>::Start() {
+    handle_.resume();
+}
+
+template<class T>
+bool Task<T>::IsDone() const noexcept {
+    return handle_.done();
+}
+
+template<class T>
+T Task<T>::Result() {
+    return std::move(handle_.promise().value).value();
+}
+
+}
+
+#endif //PLAY_TASK_INL
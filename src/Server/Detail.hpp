@@ -0,0 +1,63 @@
+#ifndef SERVER_DETAIL
+#define SERVER_DETAIL
+
+#include <string>
+#include <random>
+#include <optional>
+#include <filesystem>
+
+#include <sys/un.h>
+
+#include "../Play/Session.hpp"
+
+namespace server::detail {
+
+[[nodiscard]]
+static inline std::optional<std::uint64_t> ExtractUnsignedArgument(std::string_view argument) noexcept;
+
+// dotted ipv4, like 127.0.0.1, in host byte order
+[[nodiscard]]
+static inline std::optional<std::uint32_t> ExtractHostArgument(std::string_view argument);
+
+// longest line a player may send, a connection which goes beyond it is closed
+constexpr std::size_t kMaxLineSize = 4096;
+
+// answers a player has not taken yet, beyond them the lines wait unplayed and the socket unread
+constexpr std::size_t kMaxPendingOutput = 64 * 1024;
+
+struct Connection final {
+    play::Session<std::mt19937_64> session;
+    play::OutputSink sink;
+    std::string input;
+    bool is_input_closed;
+    // what epoll watches the socket for
+    std::uint32_t events;
+};
+
+// plays the complete lines, and the last one once the input is closed, while the output is within its limit;
+// true if any line was played
+static inline bool FeedLines(Connection &connection);
+
+// the line which has not ended yet
+[[nodiscard]]
+static inline std::size_t PartialLineSize(std::string_view input) noexcept;
+
+[[nodiscard]]
+static inline int OpenTcpListener(std::uint32_t host, std::uint16_t port, int backlog);
+
+// a socket file nobody listens on anymore is replaced, anything else at path makes it fail
+[[nodiscard]]
+static inline int OpenUnixListener(const std::filesystem::path &path, int backlog);
+
+// whether the path of address is a unix socket which refuses connections, what a server that is gone leaves behind
+[[nodiscard]]
+static inline bool IsStaleUnixSocket(const sockaddr_un &address);
+
+[[nodiscard]]
+static inline std::uint16_t ListenerPort(int listener) noexcept;
+
+}
+
+#include "Detail.inl"
+
+#endif //SERVER_DETAIL
@@ -0,0 +1,133 @@
+#ifndef SERVER_DETAIL_INL
+#define SERVER_DETAIL_INL
+
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+
+#include <cerrno>
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace server::detail {
+
+std::optional<std::uint64_t> ExtractUnsignedArgument(const std::string_view argument) noexcept {
+    std::uint64_t value = 0;
+    const auto last = argument.data() + argument.size();
+    const auto [end, error] = std::from_chars(argument.data(), last, value);
+    if (error != std::errc{} || end != last) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::uint32_t> ExtractHostArgument(const std::string_view argument) {
+    in_addr address{};
+    if (::inet_pton(AF_INET, std::string{argument}.c_str(), &address) != 1) {
+        return std::nullopt;
+    }
+    return ntohl(address.s_addr);
+}
+
+bool FeedLines(Connection &connection) {
+    std::size_t line_begin = 0;
+    while (!connection.session.IsFinished() && line_begin < connection.input.size() &&
+           connection.sink.Buffer().size() < kMaxPendingOutput) {
+        auto line_end = connection.input.find('\n', line_begin);
+        if (line_end == std::string::npos) {
+            if (!connection.is_input_closed) {
+                break;
+            }
+            line_end = connection.input.size();
+        }
+        connection.session.Feed(std::string_view{connection.input}.substr(line_begin, line_end - line_begin),
+                                connection.sink);
+        line_begin = std::min(line_end + 1, connection.input.size());
+    }
+    // nothing is read after the game is over
+    if (connection.session.IsFinished()) {
+        connection.input.clear();
+    } else {
+        connection.input.erase(0, line_begin);
+    }
+    return line_begin != 0;
+}
+
+std::size_t PartialLineSize(const std::string_view input) noexcept {
+    const auto line_end = input.rfind('\n');
+    return line_end == std::string_view::npos ? input.size() : input.size() - line_end - 1;
+}
+
+int OpenTcpListener(const std::uint32_t host, const std::uint16_t port, const int backlog) {
+    const auto listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        return -1;
+    }
+    const int enable = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(host);
+    if (::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, backlog) != 0) {
+        ::close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+int OpenUnixListener(const std::filesystem::path &path, const int backlog) {
+    sockaddr_un address{};
+    if (path.native().size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.native().size());
+    // a socket file left by a previous server would make bind fail, anything else there makes it fail on purpose
+    if (IsStaleUnixSocket(address)) {
+        ::unlink(path.c_str());
+    }
+    const auto listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        return -1;
+    }
+    if (::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, backlog) != 0) {
+        ::close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+bool IsStaleUnixSocket(const sockaddr_un &address) {
+    struct stat status{};
+    if (::lstat(address.sun_path, &status) != 0 || !S_ISSOCK(status.st_mode)) {
+        return false;
+    }
+    const auto probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        return false;
+    }
+    const auto is_refused = ::connect(probe, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 &&
+        errno == ECONNREFUSED;
+    ::close(probe);
+    return is_refused;
+}
+
+std::uint16_t ListenerPort(const int listener) noexcept {
+    sockaddr_in address{};
+    socklen_t size = sizeof(address);
+    if (::getsockname(listener, reinterpret_cast<sockaddr *>(&address), &size) != 0 || address.sin_family != AF_INET) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+}
+
+#endif //SERVER_DETAIL_INL
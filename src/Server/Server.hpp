@@ -0,0 +1,88 @@
+#ifndef SERVER_SERVER
+#define SERVER_SERVER
+
+#include <span>
+#include <ostream>
+#include <unordered_map>
+
+#include "Detail.hpp"
+#include "../Play/Hamurabi.hpp"
+
+namespace server {
+
+struct Options final {
+    // an ipv4 address in host byte order, players from elsewhere need it named
+    std::uint32_t host = INADDR_LOOPBACK;
+    std::uint16_t port = 0;
+    std::filesystem::path unix_path;
+    std::optional<std::uint64_t> seed;
+    int backlog = 1024;
+    play::InputMode input_mode = play::InputMode::Prompted;
+};
+
+extern const hamurabi::string_literal kServeFlag;
+
+[[nodiscard]]
+static inline bool IsServe(std::span<const std::string_view> arguments) noexcept;
+
+[[nodiscard]]
+static inline std::optional<Options> ExtractOptions(std::span<const std::string_view> arguments);
+
+static inline void InsertUsage(std::ostream &ostream);
+
+// every connection plays its own game, one thread serves them all through epoll
+class Server final {
+  public:
+    Server(Server &&other) noexcept;
+    Server &operator=(Server &&other) noexcept;
+
+    Server(const Server &) = delete;
+    Server &operator=(const Server &) = delete;
+
+    ~Server();
+
+    // listens on the unix socket when its path is given, otherwise on the tcp port, 0 picks a free one
+    [[nodiscard]]
+    static std::optional<Server> Open(const Options &options);
+
+    [[nodiscard]]
+    std::uint16_t Port() const noexcept;
+
+    [[nodiscard]]
+    std::size_t SessionCount() const noexcept;
+
+    // serves until Stop is called, from any thread
+    void Run();
+
+    void Stop() noexcept;
+
+  private:
+    Server(int listener, int epoll, int event, int reserve, std::filesystem::path unix_path, std::uint64_t seed,
+           play::InputMode input_mode);
+
+    void Accept();
+
+    void Receive(int descriptor, detail::Connection &connection);
+
+    [[nodiscard]]
+    bool Send(int descriptor, detail::Connection &connection);
+
+    void Close(int descriptor);
+
+    int listener_;
+    int epoll_;
+    int event_;
+    // held open to be given up when accept runs out of descriptors, so the pending connection can be refused
+    int reserve_;
+    std::filesystem::path unix_path_;
+    std::uint64_t seed_;
+    play::InputMode input_mode_;
+    std::uint64_t next_session_;
+    std::unordered_map<int, detail::Connection> connections_;
+};
+
+}
+
+#include "Server.inl"
+
+#endif //SERVER_SERVER
@@ -0,0 +1,313 @@
+#ifndef SERVER_SERVER_INL
+#define SERVER_SERVER_INL
+
+#include <array>
+#include <utility>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace server {
+
+constexpr hamurabi::string_literal kServeFlag = "--serve";
+
+bool IsServe(const std::span<const std::string_view> arguments) noexcept {
+    return std::find(arguments.begin(), arguments.end(), kServeFlag) != arguments.end();
+}
+
+std::optional<Options> ExtractOptions(const std::span<const std::string_view> arguments) {
+    Options options{};
+    for (std::size_t index = 0; index < arguments.size(); ++index) {
+        const auto argument = arguments[index];
+        if (argument == kServeFlag) {
+            continue;
+        }
+        if (argument == play::kCompactFlag) {
+            options.input_mode = play::InputMode::Compact;
+            continue;
+        }
+        if (index + 1 >= arguments.size()) {
+            return std::nullopt;
+        }
+        const auto value = arguments[++index];
+        const auto number = detail::ExtractUnsignedArgument(value);
+        if (argument == "--host") {
+            const auto host = detail::ExtractHostArgument(value);
+            if (!host.has_value()) {
+                return std::nullopt;
+            }
+            options.host = *host;
+        } else if (argument == "--port" && number.has_value() && *number <= UINT16_MAX) {
+            options.port = static_cast<std::uint16_t>(*number);
+        } else if (argument == "--unix" && !value.empty()) {
+            options.unix_path = value;
+        } else if (argument == "--seed" && number.has_value()) {
+            options.seed = *number;
+        } else if (argument == "--backlog" && number.has_value() && *number != 0 && *number <= INT32_MAX) {
+            options.backlog = static_cast<int>(*number);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+void InsertUsage(std::ostream &ostream) {
+    ostream << "usage: Hamurabi --serve [[--host A] [--port P] | --unix PATH] [--seed S] [--backlog B] [--compact]\n"
+               "tcp listens on 127.0.0.1 unless --host names another ipv4 address, like 0.0.0.0\n";
+}
+
+inline Server::Server(const int listener, const int epoll, const int event, const int reserve,
+                      std::filesystem::path unix_path, const std::uint64_t seed,
+                      const play::InputMode input_mode)
+    : listener_{listener},
+      epoll_{epoll},
+      event_{event},
+      reserve_{reserve},
+      unix_path_{std::move(unix_path)},
+      seed_{seed},
+      input_mode_{input_mode},
+      next_session_{0} {}
+
+inline Server::Server(Server &&other) noexcept
+    : listener_{std::exchange(other.listener_, -1)},
+      epoll_{std::exchange(other.epoll_, -1)},
+      event_{std::exchange(other.event_, -1)},
+      reserve_{std::exchange(other.reserve_, -1)},
+      unix_path_{std::exchange(other.unix_path_, {})},
+      seed_{other.seed_},
+      input_mode_{other.input_mode_},
+      next_session_{other.next_session_},
+      connections_{std::exchange(other.connections_, {})} {}
+
+inline Server &Server::operator=(Server &&other) noexcept {
+    std::swap(listener_, other.listener_);
+    std::swap(epoll_, other.epoll_);
+    std::swap(event_, other.event_);
+    std::swap(reserve_, other.reserve_);
+    std::swap(unix_path_, other.unix_path_);
+    std::swap(seed_, other.seed_);
+    std::swap(input_mode_, other.input_mode_);
+    std::swap(next_session_, other.next_session_);
+    std::swap(connections_, other.connections_);
+    return *this;
+}
+
+inline Server::~Server() {
+    for (const auto &[descriptor, connection] : connections_) {
+        ::close(descriptor);
+    }
+    for (const auto descriptor : {listener_, epoll_, event_, reserve_}) {
+        if (descriptor >= 0) {
+            ::close(descriptor);
+        }
+    }
+    if (listener_ >= 0 && !unix_path_.empty()) {
+        ::unlink(unix_path_.c_str());
+    }
+}
+
+inline std::optional<Server> Server::Open(const Options &options) {
+    const auto listener = options.unix_path.empty()
+        ? detail::OpenTcpListener(options.host, options.port, options.backlog)
+        : detail::OpenUnixListener(options.unix_path, options.backlog);
+    if (listener < 0) {
+        return std::nullopt;
+    }
+    const auto seed = options.seed.has_value() ? *options.seed : std::random_device{}();
+    // from here on the server owns the descriptors and closes them on failure
+    Server server{listener, ::epoll_create1(EPOLL_CLOEXEC), ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                  ::open("/dev/null", O_RDONLY | O_CLOEXEC), options.unix_path, seed, options.input_mode};
+    if (server.epoll_ < 0 || server.event_ < 0 || server.reserve_ < 0) {
+        return std::nullopt;
+    }
+    for (const auto descriptor : {server.listener_, server.event_}) {
+        epoll_event event{.events = EPOLLIN, .data = {.fd = descriptor}};
+        if (::epoll_ctl(server.epoll_, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+            return std::nullopt;
+        }
+    }
+    return server;
+}
+
+inline std::uint16_t Server::Port() const noexcept {
+    return detail::ListenerPort(listener_);
+}
+
+inline std::size_t Server::SessionCount() const noexcept {
+    return connections_.size();
+}
+
+inline void Server::Run() {
+    std::array<epoll_event, 256> events{};
+    while (true) {
+        const auto count = ::epoll_wait(epoll_, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        for (const auto &event : std::span{events}.first(static_cast<std::size_t>(count))) {
+            const auto descriptor = event.data.fd;
+            if (descriptor == event_) {
+                std::uint64_t value = 0;
+                (void) ::read(event_, &value, sizeof(value));
+                return;
+            }
+            if (descriptor == listener_) {
+                Accept();
+                continue;
+            }
+            const auto connection = connections_.find(descriptor);
+            if (connection == connections_.end()) {
+                continue;
+            }
+            if ((event.events & EPOLLERR) != 0) {
+                Close(descriptor);
+                continue;
+            }
+            if ((event.events & (EPOLLIN | EPOLLHUP)) != 0 && !connection->second.is_input_closed) {
+                Receive(descriptor, connection->second);
+            } else if (!Send(descriptor, connection->second)) {
+                Close(descriptor);
+            }
+        }
+    }
+}
+
+inline void Server::Stop() noexcept {
+    const std::uint64_t value = 1;
+    (void) ::write(event_, &value, sizeof(value));
+}
+
+inline void Server::Accept() {
+    while (true) {
+        const auto descriptor = ::accept4(listener_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            // the listener is level-triggered, so a connection left pending for want of a descriptor would wake
+            // the loop again at once, the reserved descriptor makes room to accept and refuse it
+            if ((errno == EMFILE || errno == ENFILE) && reserve_ >= 0) {
+                ::close(reserve_);
+                const auto refused = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+                if (refused >= 0) {
+                    ::close(refused);
+                }
+                reserve_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if (refused >= 0) {
+                    continue;
+                }
+            }
+            return;
+        }
+        // prompts are small and answered one by one, so they should not wait for more to send
+        const int enable = 1;
+        ::setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        epoll_event event{.events = EPOLLIN, .data = {.fd = descriptor}};
+        if (::epoll_ctl(epoll_, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+            ::close(descriptor);
+            continue;
+        }
+        hamurabi::Game game{std::mt19937_64{seed_ + next_session_++}};
+        auto [position, is_inserted] = connections_.try_emplace(descriptor, detail::Connection{
+            .session = play::Session{std::move(game), input_mode_},
+            .sink = play::OutputSink{},
+            .input = {},
+            .is_input_closed = false,
+            .events = EPOLLIN,
+        });
+        auto &connection = position->second;
+        connection.session.Start(connection.sink);
+        if (!Send(descriptor, connection)) {
+            Close(descriptor);
+        }
+    }
+}
+
+// plays the lines as they come, until the answers waiting to be sent reach their limit, then answers
+inline void Server::Receive(const int descriptor, detail::Connection &connection) {
+    std::array<char, 4096> buffer{};
+    while (!connection.is_input_closed && connection.sink.Buffer().size() < detail::kMaxPendingOutput) {
+        const auto size = ::recv(descriptor, buffer.data(), buffer.size(), 0);
+        if (size > 0) {
+            connection.input.append(buffer.data(), static_cast<std::size_t>(size));
+        } else if (size == 0) {
+            // the player has nothing more to say, but still gets the answers to what was said
+            connection.is_input_closed = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            Close(descriptor);
+            return;
+        }
+        (void) detail::FeedLines(connection);
+        if (detail::PartialLineSize(connection.input) > detail::kMaxLineSize) {
+            Close(descriptor);
+            return;
+        }
+    }
+
+    if (!Send(descriptor, connection)) {
+        Close(descriptor);
+    }
+}
+
+// false when the connection is done with, because it failed or there is nothing left to send or to read
+inline bool Server::Send(const int descriptor, detail::Connection &connection) {
+    // lines held back by a full output are played once it is sent
+    do {
+        while (!connection.sink.Buffer().empty()) {
+            const auto text = connection.sink.Buffer();
+            const auto size = ::send(descriptor, text.data(), text.size(), MSG_NOSIGNAL);
+            if (size > 0) {
+                connection.sink.Consume(static_cast<std::size_t>(size));
+            } else if (size < 0 && errno == EINTR) {
+                continue;
+            } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                return false;
+            }
+        }
+    } while (connection.sink.Buffer().empty() && detail::FeedLines(connection));
+
+    const auto is_pending = !connection.sink.Buffer().empty();
+    if (!is_pending && (connection.session.IsFinished() || connection.is_input_closed)) {
+        return false;
+    }
+    // the socket is watched for space only while there is something to send, and for input until it ends or the
+    // output is full
+    const auto is_reading = !connection.is_input_closed &&
+        connection.sink.Buffer().size() < detail::kMaxPendingOutput;
+    const auto events = (is_reading ? EPOLLIN : 0U) | (is_pending ? EPOLLOUT : 0U);
+    if (events != connection.events) {
+        epoll_event event{.events = events, .data = {.fd = descriptor}};
+        if (::epoll_ctl(epoll_, EPOLL_CTL_MOD, descriptor, &event) != 0) {
+            return false;
+        }
+        connection.events = events;
+    }
+    return true;
+}
+
+inline void Server::Close(const int descriptor) {
+    ::epoll_ctl(epoll_, EPOLL_CTL_DEL, descriptor, nullptr);
+    ::close(descriptor);
+    connections_.erase(descriptor);
+}
+
+}
+
+#endif //SERVER_SERVER_INL
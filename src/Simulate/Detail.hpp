@@ -0,0 +1,54 @@
+#ifndef SIMULATE_DETAIL
+#define SIMULATE_DETAIL
+
+#include <string>
+#include <optional>
+
+#include "../Hamurabi/Game.hpp"
+#include "../Hamurabi/Solver.hpp"
+#include "../Hamurabi/Trajectory.hpp"
+#include "../Hamurabi/MonteCarlo.hpp"
+#include "../Hamurabi/GreedyPolicy.hpp"
+#include "../Hamurabi/BatchSimulator.hpp"
+#include "../Hamurabi/CounterGenerator.hpp"
+
+namespace simulate::detail {
+
+[[nodiscard]]
+static inline std::optional<std::uint64_t> ExtractUnsignedArgument(std::string_view argument) noexcept;
+
+template<std::unsigned_integral U>
+static inline void InsertUnsigned(std::string &buffer, U value);
+
+static inline void InsertCsvHeader(std::string &buffer);
+
+template<class T, class I, class R>
+static inline void InsertCsvRow(std::string &buffer, std::uint64_t game_id,
+                                const hamurabi::Game<T, I, R> &game, const hamurabi::GameOutcome &outcome);
+
+template<class T, class I, class R>
+static inline void InsertBinaryRow(std::string &buffer, const hamurabi::Game<T, I, R> &game);
+
+static inline void InsertBytes(std::string &buffer, std::span<const std::byte> bytes);
+
+static inline void InsertTrajectoryHeader(std::string &buffer);
+
+static inline void InsertTrajectoryEnd(std::string &buffer);
+
+// every worker owns a copy, because the solver fills its caches while deciding
+class SolverCopyPolicy final {
+  public:
+    explicit SolverCopyPolicy(const hamurabi::Solver &solver);
+
+    template<hamurabi::GameState G>
+    hamurabi::RoundInput operator()(const G &game);
+
+  private:
+    hamurabi::Solver solver_;
+};
+
+}
+
+#include "Detail.inl"
+
+#endif //SIMULATE_DETAIL
@@ -0,0 +1,94 @@
+#ifndef SIMULATE_DETAIL_INL
+#define SIMULATE_DETAIL_INL
+
+#include <array>
+#include <charconv>
+
+#include "Detail.hpp"
+
+namespace simulate::detail {
+
+std::optional<std::uint64_t> ExtractUnsignedArgument(const std::string_view argument) noexcept {
+    std::uint64_t value = 0;
+    const auto last = argument.data() + argument.size();
+    const auto [end, error] = std::from_chars(argument.data(), last, value);
+    if (error != std::errc{} || end != last) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+template<std::unsigned_integral U>
+void InsertUnsigned(std::string &buffer, const U value) {
+    std::array<char, 24> digits{};
+    const auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+    buffer.append(digits.data(), end);
+}
+
+void InsertCsvHeader(std::string &buffer) {
+    buffer += "game,result,rank,round,population,area,grain,"
+              "dead_from_hunger_in_total,average_dead_from_hunger_percent,area_by_person\n";
+}
+
+template<class T, class I, class R>
+void InsertCsvRow(std::string &buffer, const std::uint64_t game_id,
+                  const hamurabi::Game<T, I, R> &game, const hamurabi::GameOutcome &outcome) {
+    constexpr std::array<char, 4> rank_letters = {'D', 'C', 'B', 'A'};
+
+    InsertUnsigned(buffer, game_id);
+    if (const auto statistics = std::get_if<hamurabi::Statistics>(&outcome)) {
+        buffer += ",end,";
+        buffer += rank_letters[static_cast<std::size_t>(statistics->Rank()) - static_cast<std::size_t>(hamurabi::Rank::D)];
+    } else {
+        buffer += ",game_over,";
+    }
+    for (const auto value : {game.CurrentRound(), game.Population(), game.Area(), game.Grain(),
+                             game.DeadFromHungerInTotal()}) {
+        buffer += ',';
+        InsertUnsigned(buffer, value);
+    }
+    buffer += ',';
+    if (const auto statistics = std::get_if<hamurabi::Statistics>(&outcome)) {
+        InsertUnsigned(buffer, statistics->AverageDeadFromHungerPercent());
+        buffer += ',';
+        InsertUnsigned(buffer, statistics->AreaByPerson());
+    } else {
+        buffer += ',';
+    }
+    buffer += '\n';
+}
+
+template<class T, class I, class R>
+void InsertBinaryRow(std::string &buffer, const hamurabi::Game<T, I, R> &game) {
+    std::array<std::byte, hamurabi::ser::kBinaryGameSize> bytes{};
+    hamurabi::ser::InsertGame(std::span{bytes}, game);
+    InsertBytes(buffer, bytes);
+}
+
+void InsertBytes(std::string &buffer, const std::span<const std::byte> bytes) {
+    buffer.append(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
+
+void InsertTrajectoryHeader(std::string &buffer) {
+    std::vector<std::byte> bytes;
+    hamurabi::ser::InsertTrajectoryHeader(bytes);
+    InsertBytes(buffer, bytes);
+}
+
+void InsertTrajectoryEnd(std::string &buffer) {
+    std::vector<std::byte> bytes;
+    hamurabi::ser::InsertTrajectoryEnd(bytes);
+    InsertBytes(buffer, bytes);
+}
+
+inline SolverCopyPolicy::SolverCopyPolicy(const hamurabi::Solver &solver)
+    : solver_{solver} {}
+
+template<hamurabi::GameState G>
+hamurabi::RoundInput SolverCopyPolicy::operator()(const G &game) {
+    return solver_.Decide(game);
+}
+
+}
+
+#endif //SIMULATE_DETAIL_INL
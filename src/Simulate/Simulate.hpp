@@ -0,0 +1,56 @@
+#ifndef SIMULATE_SIMULATE
+#define SIMULATE_SIMULATE
+
+#include <span>
+#include <ostream>
+
+#include "Detail.hpp"
+
+namespace simulate {
+
+enum class PolicyKind : std::uint8_t {
+    Greedy,
+    Solver,
+};
+
+enum class OutputFormat : std::uint8_t {
+    Csv,
+    Binary,
+    // per round columns, see hamurabi::serialization::TrajectoryBatch
+    Trajectory,
+    // no rows, the ranks and distributions of all games, see hamurabi::RunMonteCarlo
+    Summary,
+};
+
+struct Options final {
+    std::uint64_t games = 1;
+    std::uint64_t seed = 0;
+    PolicyKind policy = PolicyKind::Greedy;
+    std::size_t threads = 0;
+    OutputFormat format = OutputFormat::Csv;
+    std::uint64_t chunk_size = 1024;
+    bool instrument = false;
+};
+
+extern const hamurabi::string_literal kSimulateFlag;
+
+[[nodiscard]]
+static inline bool IsSimulate(std::span<const std::string_view> arguments) noexcept;
+
+[[nodiscard]]
+static inline std::optional<Options> ExtractOptions(std::span<const std::string_view> arguments);
+
+static inline void InsertUsage(std::ostream &ostream);
+
+// games are seeded with CounterGenerator{seed, game id}, rows come out in game id order whatever the thread count,
+// the report of all games is empty unless the options ask for instrumentation, which a summary does not take
+template<std::invocable M>
+hamurabi::InstrumentationReport Simulate(std::ostream &ostream, const Options &options, M make_policy);
+
+static inline hamurabi::InstrumentationReport Simulate(std::ostream &ostream, const Options &options);
+
+}
+
+#include "Simulate.inl"
+
+#endif //SIMULATE_SIMULATE
@@ -0,0 +1,250 @@
+#ifndef SIMULATE_SIMULATE_INL
+#define SIMULATE_SIMULATE_INL
+
+#include <map>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <type_traits>
+#include <condition_variable>
+
+namespace simulate {
+
+constexpr hamurabi::string_literal kSimulateFlag = "--simulate";
+
+bool IsSimulate(const std::span<const std::string_view> arguments) noexcept {
+    return std::find(arguments.begin(), arguments.end(), kSimulateFlag) != arguments.end();
+}
+
+std::optional<Options> ExtractOptions(const std::span<const std::string_view> arguments) {
+    Options options{};
+    for (std::size_t index = 0; index < arguments.size(); ++index) {
+        const auto argument = arguments[index];
+        if (argument == kSimulateFlag) {
+            continue;
+        }
+        if (argument == "--instrument") {
+            options.instrument = true;
+            continue;
+        }
+        if (index + 1 >= arguments.size()) {
+            return std::nullopt;
+        }
+        const auto value = arguments[++index];
+        const auto number = detail::ExtractUnsignedArgument(value);
+        if (argument == "--games" && number.has_value()) {
+            options.games = *number;
+        } else if (argument == "--seed" && number.has_value()) {
+            options.seed = *number;
+        } else if (argument == "--threads" && number.has_value()) {
+            options.threads = static_cast<std::size_t>(*number);
+        } else if (argument == "--chunk-size" && number.has_value() && *number != 0) {
+            options.chunk_size = *number;
+        } else if (argument == "--policy" && value == "greedy") {
+            options.policy = PolicyKind::Greedy;
+        } else if (argument == "--policy" && value == "solver") {
+            options.policy = PolicyKind::Solver;
+        } else if (argument == "--format" && value == "csv") {
+            options.format = OutputFormat::Csv;
+        } else if (argument == "--format" && value == "binary") {
+            options.format = OutputFormat::Binary;
+        } else if (argument == "--format" && value == "trajectory") {
+            options.format = OutputFormat::Trajectory;
+        } else if (argument == "--format" && value == "summary") {
+            options.format = OutputFormat::Summary;
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (options.instrument && options.format == OutputFormat::Summary) {
+        return std::nullopt;
+    }
+    // a chunk never holds more than every game
+    options.chunk_size = std::max<std::uint64_t>(1, std::min(options.chunk_size, options.games));
+    return options;
+}
+
+void InsertUsage(std::ostream &ostream) {
+    ostream << "usage: Hamurabi --simulate [--games N] [--seed S] [--policy greedy|solver] [--threads K]\n"
+               "                [--format csv|binary|trajectory|summary] [--chunk-size C] [--instrument]\n";
+}
+
+template<std::invocable M>
+hamurabi::InstrumentationReport Simulate(std::ostream &ostream, const Options &options, M make_policy) {
+    if (options.format == OutputFormat::Summary) {
+        const hamurabi::MonteCarloOptions monte_carlo_options{
+            .games = options.games,
+            .threads = options.threads,
+            .chunk_size = options.chunk_size,
+        };
+        const auto make_generator = [seed = options.seed](const std::uint64_t game_id) {
+            return hamurabi::CounterGenerator{seed, game_id};
+        };
+        const auto summary = hamurabi::RunMonteCarlo<hamurabi::CounterGenerator>(monte_carlo_options, make_generator,
+                                                                                 make_policy());
+        hamurabi::InsertSummary(ostream, summary);
+        ostream.flush();
+        return {};
+    }
+
+    const auto chunk_count = options.games / options.chunk_size + (options.games % options.chunk_size != 0 ? 1 : 0);
+    const auto hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+    const auto thread_count = static_cast<std::size_t>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(
+        options.threads == 0 ? hardware_threads : options.threads, chunk_count)));
+    // finished chunks wait here until every chunk before them is written, the window bounds how many may wait
+    const auto window = 4 * static_cast<std::uint64_t>(thread_count);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::map<std::uint64_t, std::string> finished;
+    std::uint64_t next_chunk = 0;
+    std::uint64_t next_to_write = 0;
+    bool is_failed = false;
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<hamurabi::InstrumentationReport> reports(thread_count);
+
+    const auto work = [&](const std::size_t worker) {
+        try {
+            auto policy = make_policy();
+            while (true) {
+                std::uint64_t chunk = 0;
+                {
+                    std::unique_lock lock{mutex};
+                    condition.wait(lock, [&] {
+                        return is_failed || next_chunk >= chunk_count || next_chunk < next_to_write + window;
+                    });
+                    if (is_failed || next_chunk >= chunk_count) {
+                        return;
+                    }
+                    chunk = next_chunk++;
+                }
+
+                std::string buffer;
+                const auto first = chunk * options.chunk_size;
+                const auto last = first + std::min(options.chunk_size, options.games - first);
+                // counters stay local to the chunk, the workers' reports sit next to each other
+                hamurabi::InstrumentationReport chunk_report{};
+                // a chunk is one batch of the trajectory stream
+                hamurabi::ser::TrajectoryBatch trajectory;
+                const auto play_games = [&]<class I>(std::type_identity<I>) {
+                    for (auto game_id = first; game_id < last; ++game_id) {
+                        hamurabi::Game<hamurabi::CounterGenerator, I> game{
+                            hamurabi::CounterGenerator{options.seed, game_id}};
+                        const auto outcome = [&] {
+                            if (options.format != OutputFormat::Trajectory) {
+                                return hamurabi::PlayGame(game, policy);
+                            }
+                            trajectory.Append(game_id, game);
+                            return hamurabi::PlayGame(game, policy, [&](const auto &played) {
+                                trajectory.Append(game_id, played);
+                            });
+                        }();
+                        switch (options.format) {
+                            case OutputFormat::Csv: {
+                                detail::InsertCsvRow(buffer, game_id, game, outcome);
+                                break;
+                            }
+                            case OutputFormat::Binary: {
+                                detail::InsertBinaryRow(buffer, game);
+                                break;
+                            }
+                            case OutputFormat::Trajectory: {
+                                break;
+                            }
+                        }
+                        if constexpr (std::same_as<I, hamurabi::CountingInstrumentation>) {
+                            chunk_report += game.Instrumentation().Report();
+                        }
+                    }
+                };
+                if (options.instrument) {
+                    play_games(std::type_identity<hamurabi::CountingInstrumentation>{});
+                } else {
+                    play_games(std::type_identity<hamurabi::NoInstrumentation>{});
+                }
+                if (options.format == OutputFormat::Trajectory) {
+                    detail::InsertBytes(buffer, trajectory.Encode());
+                }
+                reports[worker] += chunk_report;
+                {
+                    const std::lock_guard lock{mutex};
+                    finished.emplace(chunk, std::move(buffer));
+                }
+                condition.notify_all();
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            const std::lock_guard lock{mutex};
+            is_failed = true;
+        }
+        condition.notify_all();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count);
+    for (std::size_t worker = 0; worker < thread_count; ++worker) {
+        workers.emplace_back(work, worker);
+    }
+
+    std::string header;
+    if (options.format == OutputFormat::Csv) {
+        detail::InsertCsvHeader(header);
+    } else if (options.format == OutputFormat::Trajectory) {
+        detail::InsertTrajectoryHeader(header);
+    }
+    ostream << header;
+    for (std::uint64_t chunk = 0; chunk < chunk_count; ++chunk) {
+        std::string buffer;
+        {
+            std::unique_lock lock{mutex};
+            condition.wait(lock, [&] { return is_failed || finished.contains(chunk); });
+            if (is_failed) {
+                break;
+            }
+            auto node = finished.extract(chunk);
+            buffer = std::move(node.mapped());
+            next_to_write += 1;
+        }
+        condition.notify_all();
+        ostream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    for (auto &thread : workers) {
+        thread.join();
+    }
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    if (options.format == OutputFormat::Trajectory) {
+        std::string end;
+        detail::InsertTrajectoryEnd(end);
+        ostream << end;
+    }
+    ostream.flush();
+
+    hamurabi::InstrumentationReport report{};
+    for (const auto &worker_report : reports) {
+        report += worker_report;
+    }
+    return report;
+}
+
+hamurabi::InstrumentationReport Simulate(std::ostream &ostream, const Options &options) {
+    switch (options.policy) {
+        case PolicyKind::Greedy: {
+            return Simulate(ostream, options, [] { return hamurabi::GreedyPolicy{}; });
+        }
+        case PolicyKind::Solver: {
+            hamurabi::Solver solver{hamurabi::SolverOptions{}};
+            (void) solver.Solve();
+            return Simulate(ostream, options, [&solver] { return detail::SolverCopyPolicy{solver}; });
+        }
+    }
+    return {};
+}
+
+}
+
+#endif //SIMULATE_SIMULATE_INL
@@ -0,0 +1,49 @@
+#ifndef SWEEP_DETAIL
+#define SWEEP_DETAIL
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <optional>
+
+#include "../Hamurabi/ParameterSweep.hpp"
+#include "../Hamurabi/Solver.hpp"
+#include "../Hamurabi/GreedyPolicy.hpp"
+#include "../Simulate/Detail.hpp"
+
+namespace sweep::detail {
+
+// comma separated, like 15,20,25
+template<std::unsigned_integral U>
+[[nodiscard]]
+static inline std::optional<std::vector<U>> ExtractList(std::string_view argument);
+
+// comma separated ranges, like 17-26,15-30
+[[nodiscard]]
+static inline std::optional<std::vector<hamurabi::AcrePriceBand>> ExtractAcrePriceBands(std::string_view argument);
+
+static inline void InsertCsvHeader(std::string &buffer);
+
+static inline void InsertCsvRow(std::string &buffer, const hamurabi::SweepTable &table, std::size_t row,
+                                std::span<const hamurabi::RuntimeRules> variants,
+                                std::span<const std::string_view> policy_names);
+
+// policies of a sweep share one type, so the ones picked on the command line are a variant
+class AnyPolicy final {
+  public:
+    explicit AnyPolicy(hamurabi::GreedyPolicy policy) noexcept;
+
+    explicit AnyPolicy(hamurabi::SolverPolicy policy) noexcept;
+
+    template<hamurabi::GameState G>
+    hamurabi::RoundInput operator()(const G &game) const;
+
+  private:
+    std::variant<hamurabi::GreedyPolicy, hamurabi::SolverPolicy> policy_;
+};
+
+}
+
+#include "Detail.inl"
+
+#endif //SWEEP_DETAIL
@@ -0,0 +1,109 @@
+#ifndef SWEEP_DETAIL_INL
+#define SWEEP_DETAIL_INL
+
+#include <array>
+#include <limits>
+
+#include "Detail.hpp"
+
+namespace sweep::detail {
+
+template<std::unsigned_integral U>
+std::optional<std::vector<U>> ExtractList(std::string_view argument) {
+    std::vector<U> values;
+    while (true) {
+        const auto comma = argument.find(',');
+        const auto number = simulate::detail::ExtractUnsignedArgument(argument.substr(0, comma));
+        if (!number.has_value() || *number > std::numeric_limits<U>::max()) {
+            return std::nullopt;
+        }
+        values.push_back(static_cast<U>(*number));
+        if (comma == std::string_view::npos) {
+            return values;
+        }
+        argument.remove_prefix(comma + 1);
+    }
+}
+
+std::optional<std::vector<hamurabi::AcrePriceBand>> ExtractAcrePriceBands(std::string_view argument) {
+    std::vector<hamurabi::AcrePriceBand> bands;
+    while (true) {
+        const auto comma = argument.find(',');
+        const auto band = argument.substr(0, comma);
+        const auto dash = band.find('-');
+        if (dash == std::string_view::npos) {
+            return std::nullopt;
+        }
+        const auto min = simulate::detail::ExtractUnsignedArgument(band.substr(0, dash));
+        const auto max = simulate::detail::ExtractUnsignedArgument(band.substr(dash + 1));
+        // free land is no rule a game can be played by
+        if (!min.has_value() || !max.has_value() || *min == 0) {
+            return std::nullopt;
+        }
+        bands.push_back({.min = static_cast<hamurabi::Bushels>(*min), .max = static_cast<hamurabi::Bushels>(*max)});
+        if (comma == std::string_view::npos) {
+            return bands;
+        }
+        argument.remove_prefix(comma + 1);
+    }
+}
+
+void InsertCsvHeader(std::string &buffer) {
+    buffer += "variant,grain_per_person,plague_percent,game_over_percent,min_acre_price,max_acre_price,policy,"
+              "game,result,rank,round,population,area,grain,"
+              "dead_from_hunger_in_total,average_dead_from_hunger_percent,area_by_person\n";
+}
+
+void InsertCsvRow(std::string &buffer, const hamurabi::SweepTable &table, const std::size_t row,
+                  const std::span<const hamurabi::RuntimeRules> variants,
+                  const std::span<const std::string_view> policy_names) {
+    constexpr std::array<char, 4> rank_letters = {'D', 'C', 'B', 'A'};
+    using simulate::detail::InsertUnsigned;
+
+    const auto &rules = variants[table.variant[row]];
+    InsertUnsigned(buffer, table.variant[row]);
+    for (const auto value : {rules.GrainPerPerson(), static_cast<hamurabi::Bushels>(rules.MaxPlagueCanOccurPercent()),
+                             rules.MinDeadFromHungerPercentToGameOver(), rules.MinAcrePrice(), rules.MaxAcrePrice()}) {
+        buffer += ',';
+        InsertUnsigned(buffer, value);
+    }
+    buffer += ',';
+    buffer += policy_names[table.policy[row]];
+    buffer += ',';
+    InsertUnsigned(buffer, table.game[row]);
+    if (table.is_game_over[row] != 0) {
+        buffer += ",game_over,";
+    } else {
+        buffer += ",end,";
+        buffer += rank_letters[table.rank[row] - static_cast<std::size_t>(hamurabi::Rank::D)];
+    }
+    for (const auto value : {table.round[row], table.population[row], table.area[row], table.grain[row],
+                             table.dead_from_hunger_in_total[row]}) {
+        buffer += ',';
+        InsertUnsigned(buffer, value);
+    }
+    buffer += ',';
+    if (table.is_game_over[row] == 0) {
+        InsertUnsigned(buffer, table.average_dead_from_hunger_percent[row]);
+        buffer += ',';
+        InsertUnsigned(buffer, table.area_by_person[row]);
+    } else {
+        buffer += ',';
+    }
+    buffer += '\n';
+}
+
+inline AnyPolicy::AnyPolicy(const hamurabi::GreedyPolicy policy) noexcept
+    : policy_{policy} {}
+
+inline AnyPolicy::AnyPolicy(const hamurabi::SolverPolicy policy) noexcept
+    : policy_{policy} {}
+
+template<hamurabi::GameState G>
+hamurabi::RoundInput AnyPolicy::operator()(const G &game) const {
+    return std::visit([&](const auto &policy) { return hamurabi::RoundInput{policy(game)}; }, policy_);
+}
+
+}
+
+#endif //SWEEP_DETAIL_INL
@@ -0,0 +1,38 @@
+#ifndef SWEEP_SWEEP
+#define SWEEP_SWEEP
+
+#include <span>
+#include <ostream>
+
+#include "Detail.hpp"
+#include "../Simulate/Simulate.hpp"
+
+namespace sweep {
+
+struct Options final {
+    std::uint64_t games = 1;
+    std::uint64_t seed = 0;
+    std::vector<simulate::PolicyKind> policies = {simulate::PolicyKind::Greedy};
+    hamurabi::SweepGrid grid;
+};
+
+extern const hamurabi::string_literal kSweepFlag;
+
+[[nodiscard]]
+static inline bool IsSweep(std::span<const std::string_view> arguments) noexcept;
+
+[[nodiscard]]
+static inline std::optional<Options> ExtractOptions(std::span<const std::string_view> arguments);
+
+static inline void InsertUsage(std::ostream &ostream);
+
+// game g of every variant and policy is seeded with CounterGenerator{seed, g}, the table is written as csv
+static inline hamurabi::SweepTable Sweep(std::ostream &ostream, const Options &options);
+
+static inline void InsertSharing(std::ostream &ostream, const hamurabi::SweepTable &table);
+
+}
+
+#include "Sweep.inl"
+
+#endif //SWEEP_SWEEP
@@ -0,0 +1,149 @@
+#ifndef SWEEP_SWEEP_INL
+#define SWEEP_SWEEP_INL
+
+#include <algorithm>
+
+namespace sweep {
+
+constexpr hamurabi::string_literal kSweepFlag = "--sweep";
+
+bool IsSweep(const std::span<const std::string_view> arguments) noexcept {
+    return std::find(arguments.begin(), arguments.end(), kSweepFlag) != arguments.end();
+}
+
+std::optional<Options> ExtractOptions(const std::span<const std::string_view> arguments) {
+    Options options{};
+    for (std::size_t index = 0; index < arguments.size(); ++index) {
+        const auto argument = arguments[index];
+        if (argument == kSweepFlag) {
+            continue;
+        }
+        if (index + 1 >= arguments.size()) {
+            return std::nullopt;
+        }
+        const auto value = arguments[++index];
+        const auto number = simulate::detail::ExtractUnsignedArgument(value);
+        if (argument == "--games" && number.has_value()) {
+            options.games = *number;
+        } else if (argument == "--seed" && number.has_value()) {
+            options.seed = *number;
+        } else if (argument == "--policy" && (value == "greedy" || value == "solver" || value == "greedy,solver")) {
+            options.policies.clear();
+            if (value != "solver") {
+                options.policies.push_back(simulate::PolicyKind::Greedy);
+            }
+            if (value != "greedy") {
+                options.policies.push_back(simulate::PolicyKind::Solver);
+            }
+        } else if (argument == "--grain-per-person") {
+            auto values = detail::ExtractList<hamurabi::Bushels>(value);
+            if (!values.has_value()) {
+                return std::nullopt;
+            }
+            options.grid.grain_per_person = std::move(*values);
+        } else if (argument == "--plague-percent") {
+            auto values = detail::ExtractList<std::uint_fast16_t>(value);
+            if (!values.has_value()) {
+                return std::nullopt;
+            }
+            options.grid.max_plague_can_occur_percent = std::move(*values);
+        } else if (argument == "--game-over-percent") {
+            auto values = detail::ExtractList<hamurabi::People>(value);
+            if (!values.has_value()) {
+                return std::nullopt;
+            }
+            options.grid.min_dead_from_hunger_percent_to_game_over = std::move(*values);
+        } else if (argument == "--acre-price") {
+            auto bands = detail::ExtractAcrePriceBands(value);
+            if (!bands.has_value()) {
+                return std::nullopt;
+            }
+            options.grid.acre_price_band = std::move(*bands);
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    // ExpandGrid leaves out combinations that are no rules, on the command line that is a mistake to report
+    const auto axis_size = [](const auto &values) {
+        return std::max<std::size_t>(1, values.size());
+    };
+    const auto combination_count = axis_size(options.grid.grain_per_person) *
+        axis_size(options.grid.max_plague_can_occur_percent) *
+        axis_size(options.grid.min_dead_from_hunger_percent_to_game_over) *
+        axis_size(options.grid.acre_price_band);
+    const auto variants = hamurabi::ExpandGrid(options.grid);
+    if (variants.size() != combination_count) {
+        return std::nullopt;
+    }
+    // the solver plans by the default rules, its decisions say nothing about any other variant
+    const auto is_solver = std::find(options.policies.begin(), options.policies.end(),
+                                     simulate::PolicyKind::Solver) != options.policies.end();
+    const auto is_default = [&options](const hamurabi::RuntimeRules &rules) {
+        return rules.Values() == options.grid.base;
+    };
+    if (is_solver && !std::all_of(variants.begin(), variants.end(), is_default)) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+void InsertUsage(std::ostream &ostream) {
+    ostream << "usage: Hamurabi --sweep [--games N] [--seed S] [--policy greedy|solver|greedy,solver]\n"
+               "                [--grain-per-person G,...] [--plague-percent P,...] [--game-over-percent D,...]\n"
+               "                [--acre-price MIN-MAX,...]\n"
+               "every combination must be playable rules, and the solver only plays the default rules\n";
+}
+
+hamurabi::SweepTable Sweep(std::ostream &ostream, const Options &options) {
+    const auto variants = hamurabi::ExpandGrid(options.grid);
+
+    std::optional<hamurabi::Solver> solver;
+    std::vector<detail::AnyPolicy> policies;
+    std::vector<std::string_view> policy_names;
+    for (const auto kind : options.policies) {
+        switch (kind) {
+            case simulate::PolicyKind::Greedy: {
+                policies.emplace_back(hamurabi::GreedyPolicy{});
+                policy_names.emplace_back("greedy");
+                break;
+            }
+            case simulate::PolicyKind::Solver: {
+                if (!solver.has_value()) {
+                    solver.emplace(hamurabi::SolverOptions{});
+                    (void) solver->Solve();
+                }
+                policies.emplace_back(hamurabi::SolverPolicy{*solver});
+                policy_names.emplace_back("solver");
+                break;
+            }
+        }
+    }
+
+    const auto make_generator = [&options](const std::uint64_t game_id) {
+        return hamurabi::CounterGenerator{options.seed, game_id};
+    };
+    const auto table = hamurabi::RunSweep<hamurabi::CounterGenerator>(variants, options.games, make_generator,
+                                                                      std::span{policies});
+
+    std::string buffer;
+    detail::InsertCsvHeader(buffer);
+    for (std::size_t row = 0; row < table.Size(); ++row) {
+        detail::InsertCsvRow(buffer, table, row, variants, policy_names);
+        if (buffer.size() >= 1 << 16) {
+            ostream << buffer;
+            buffer.clear();
+        }
+    }
+    ostream << buffer;
+    ostream.flush();
+    return table;
+}
+
+void InsertSharing(std::ostream &ostream, const hamurabi::SweepTable &table) {
+    ostream << "played " << table.played_rounds << " of " << table.variant_rounds << " variant rounds\n";
+}
+
+}
+
+#endif //SWEEP_SWEEP_INL
@@ -0,0 +1,42 @@
+#include <thread>
+#include <iostream>
+
+#include "../Bench/Benchmarks.hpp"
+
+// a wave of sessions played through the server must print exactly what the same sessions print in process
+int main() {
+    namespace detail = bench::detail;
+
+    const auto path = detail::LoopbackPath();
+    auto server = server::Server::Open({.unix_path = path, .seed = detail::kLoopbackSeed});
+    if (!server.has_value()) {
+        std::cerr << "hamurabi_server_test: cannot listen on " << path << "\n";
+        return 1;
+    }
+    std::thread thread{[&server] { server->Run(); }};
+
+    const auto lines = detail::InsertLoopbackWave();
+    std::vector<int> descriptors;
+    descriptors.reserve(lines.size());
+    for (const auto &session_lines : lines) {
+        descriptors.push_back(detail::ConnectLoopbackClient(path, session_lines));
+    }
+    std::size_t mismatches = 0;
+    for (std::size_t session = 0; session < lines.size(); ++session) {
+        const auto descriptor = descriptors[session];
+        const auto transcript = descriptor < 0 ? std::nullopt : detail::ReceiveTranscript(descriptor);
+        mismatches += transcript != detail::PlayPromptedSession(detail::kLoopbackSeed + session, lines[session]);
+        if (descriptor >= 0) {
+            ::close(descriptor);
+        }
+    }
+
+    server->Stop();
+    thread.join();
+    if (mismatches != 0) {
+        std::cerr << "hamurabi_server_test: " << mismatches << " of " << lines.size()
+                  << " sessions played through the server differ from the ones played in process\n";
+        return 1;
+    }
+    return 0;
+}
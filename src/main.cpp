@@ -1,12 +1,59 @@
+#include <vector>
 #include <iostream>
 
 #include "Play/Hamurabi.hpp"
+#include "Server/Server.hpp"
+#include "Simulate/Simulate.hpp"
+#include "Sweep/Sweep.hpp"
+
+int main(int argc, char *argv[]) {
+    const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+    if (simulate::IsSimulate(arguments)) {
+        const auto options = simulate::ExtractOptions(arguments);
+        if (!options.has_value()) {
+            simulate::InsertUsage(std::cerr);
+            return 1;
+        }
+        std::ios::sync_with_stdio(false);
+        const auto report = simulate::Simulate(std::cout, options.value());
+        if (options->instrument) {
+            hamurabi::InsertReport(std::cerr, report);
+        }
+        return 0;
+    }
+    if (sweep::IsSweep(arguments)) {
+        const auto options = sweep::ExtractOptions(arguments);
+        if (!options.has_value()) {
+            sweep::InsertUsage(std::cerr);
+            return 1;
+        }
+        std::ios::sync_with_stdio(false);
+        const auto table = sweep::Sweep(std::cout, options.value());
+        sweep::InsertSharing(std::cerr, table);
+        return 0;
+    }
+    if (server::IsServe(arguments)) {
+        const auto options = server::ExtractOptions(arguments);
+        if (!options.has_value()) {
+            server::InsertUsage(std::cerr);
+            return 1;
+        }
+        auto game_server = server::Server::Open(options.value());
+        if (!game_server.has_value()) {
+            std::cerr << "Hamurabi: cannot listen for players\n";
+            return 1;
+        }
+        game_server->Run();
+        return 0;
+    }
 
-int main() {
     std::random_device random_device{};
     std::mt19937_64 generator{random_device()};
     hamurabi::Game game{generator};
     std::fstream file{};
-    play::Hamurabi(std::cin, std::cout, file, game);
+    const auto input_mode = std::find(arguments.begin(), arguments.end(), play::kCompactFlag) != arguments.end()
+        ? play::InputMode::Compact
+        : play::InputMode::Prompted;
+    play::Hamurabi(std::cin, std::cout, file, game, {}, input_mode);
     return 0;
 }